@@ -0,0 +1,102 @@
+// Searches a fixed set of positions to a fixed depth, so that node counts do not depend
+// on timing, and reports nodes, time and nodes per second. The signature combines the
+// node counts and best moves of all positions; a change of it means the search itself
+// changed, not just its speed.
+//
+// Usage: gomoku_bench [depth] [zobrist seed] [network]
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "core.h"
+#include "hash.h"
+
+namespace {
+
+/**
+ * @struct Position
+ * @brief A benchmark position given by its moves, black first.
+ */
+struct Position {
+    const char *name;                       /**< The name of the position. */
+    std::vector<MoveGenerator::Move> moves; /**< The moves played, alternating colors. */
+};
+
+const Position POSITIONS[] = {
+    {"opening/center", {{7, 7}}},
+    {"opening/direct", {{7, 7}, {7, 8}}},
+    {"opening/indirect", {{7, 7}, {6, 8}}},
+    {"opening/four", {{7, 7}, {6, 8}, {8, 8}, {6, 6}}},
+    {"middlegame/1",
+     {{7, 7}, {6, 8}, {8, 8}, {6, 6}, {6, 7}, {8, 6}, {5, 8}, {9, 9}, {7, 9}, {7, 6}}},
+    {"middlegame/2",
+     {{7, 7}, {7, 8}, {8, 7}, {6, 7}, {8, 8}, {8, 6}, {9, 9}, {10, 10}, {6, 9}, {5, 10},
+      {9, 7}, {10, 7}}},
+    {"tactical/open-three", {{7, 5}, {6, 6}, {7, 6}, {8, 8}, {7, 7}}},
+    {"tactical/four-three",
+     {{7, 5}, {7, 4}, {7, 6}, {9, 9}, {7, 7}, {10, 3}, {5, 8}, {3, 11}, {6, 8}, {11, 11}}},
+};
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    EngineConfig config;
+    config.iterativeDeepening = false;
+    config.minSearchDepth = argc > 1 ? std::atoi(argv[1]) : 6;
+    config.timeLimit = INT_MAX;
+    if (argc > 2) Zobrist::setSeed(std::strtoull(argv[2], nullptr, 0));
+    Network network;
+    if (argc > 3) {
+        if (!network.load<Board::BOARD_SIZE>(argv[3])) {
+            fprintf(stderr, "Cannot load network %s\n", argv[3]);
+            return 1;
+        }
+        config.network = &network;
+    }
+
+    long long totalNodes = 0;
+    double totalMs = 0;
+    unsigned long long signature = 14695981039346656037ULL;
+
+    printf("%-22s %5s %7s %12s %12s %10s %12s\n", "position", "depth", "move", "score",
+           "nodes", "ms", "nps");
+    for (const Position &position : POSITIONS) {
+        Board board;
+        int color = Board::PIECE_COLOR::BLACK;
+        for (const MoveGenerator::Move &move : position.moves) {
+            board.placeAt(move.x, move.y, static_cast<Board::PIECE_COLOR>(color));
+            color ^= 1;
+        }
+
+        Core core(&board, static_cast<Board::PIECE_COLOR>(color), config);
+        core.initTimer();
+        auto start = std::chrono::high_resolution_clock::now();
+        core.run();
+        double ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::high_resolution_clock::now() - start)
+                        .count();
+
+        MoveGenerator::Move best = core.bestMove();
+        long long nodes = core.cntNodes();
+        totalNodes += nodes;
+        totalMs += ms;
+        for (long long value : {nodes, (long long)best.x, (long long)best.y}) {
+            signature = (signature ^ (unsigned long long)value) * 1099511628211ULL;
+        }
+
+        char move[16];
+        snprintf(move, sizeof(move), "%d,%d", best.x, best.y);
+        printf("%-22s %5d %7s %12d %12lld %10.1f %12.0f\n", position.name,
+               core.bestDepth(), move, core.bestScore(), nodes, ms,
+               ms > 0 ? nodes / ms * 1000 : 0.0);
+    }
+
+    printf("\ntotal nodes: %lld\n", totalNodes);
+    printf("total time: %.1f ms\n", totalMs);
+    printf("nps: %.0f\n", totalMs > 0 ? totalNodes / totalMs * 1000 : 0.0);
+    printf("signature: %016llx\n", signature);
+    return 0;
+}
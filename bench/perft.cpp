@@ -0,0 +1,235 @@
+// Replays random move sequences through Core::makeMove and Core::cancelMove, which drive
+// the incremental scoring of MoveGenerator, and reports make/unmake pairs per second.
+// With verification on, the incremental state is compared after every make and unmake
+// with a Core built from scratch on the same board, whose scores come from the full-board
+// BasicLineScanner instead of Core::updateMoveAt. Verification mode 2 draws the moves
+// from every empty cell instead of the candidate list, like the far moves an opponent or a
+// human may play. Verification also plays such games through Engine::play and
+// Engine::setPosition on the standard board.
+//
+// Usage: gomoku_perft [games] [plies] [verify (0/1/2)] [seed] [board size (15/19/20)]
+//                     [rule (freestyle/standard/renju)] [network]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "core.h"
+#include "engine.h"
+
+namespace {
+
+/**
+ * @brief Compares the incremental move generator of a core with one built from scratch.
+ * @return The number of differences, each of them printed.
+ */
+template <int N>
+int verify(const BasicCore<N> &core, BasicBoard<N> *pBoard,
+           BoardBase::PIECE_COLOR color) {
+    BasicCore<N> fresh(pBoard, color, core.config());
+    const BasicMoveGenerator<N> &incremental = core.moveGenerator();
+    const BasicMoveGenerator<N> &expected = fresh.moveGenerator();
+
+    int cntErrors = 0;
+    for (int x = 0; x < N; x++) {
+        for (int y = 0; y < N; y++) {
+            MoveGeneratorBase::Move move = {x, y};
+            if (incremental.existsMove(move) != expected.existsMove(move)) {
+                printf("move %d,%d: exists %d, expected %d\n", x, y,
+                       incremental.existsMove(move), expected.existsMove(move));
+                cntErrors++;
+                continue;
+            }
+            if (!expected.existsMove(move)) continue;
+
+            for (int c = 0; c < 2; c++) {
+                BoardBase::PIECE_COLOR player = static_cast<BoardBase::PIECE_COLOR>(c);
+                if (incremental.playerMoveScore(move, player) !=
+                    expected.playerMoveScore(move, player)) {
+                    printf("move %d,%d color %d: score %d, expected %d\n", x, y, c,
+                           incremental.playerMoveScore(move, player),
+                           expected.playerMoveScore(move, player));
+                    cntErrors++;
+                }
+            }
+            if (incremental.maxMoveScore(move) != expected.maxMoveScore(move)) {
+                printf("move %d,%d: max score %d, expected %d\n", x, y,
+                       incremental.maxMoveScore(move), expected.maxMoveScore(move));
+                cntErrors++;
+            }
+        }
+    }
+
+    for (int c = 0; c < 2; c++) {
+        BoardBase::PIECE_COLOR player = static_cast<BoardBase::PIECE_COLOR>(c);
+        if (incremental.sumPlayerScore(player) != expected.sumPlayerScore(player)) {
+            printf("color %d: sum %d, expected %d\n", c, incremental.sumPlayerScore(player),
+                   expected.sumPlayerScore(player));
+            cntErrors++;
+        }
+    }
+    if (core.evaluate() != core.evaluateFromScratch()) {
+        printf("evaluation %d, expected %d\n", core.evaluate(), core.evaluateFromScratch());
+        cntErrors++;
+    }
+    return cntErrors;
+}
+
+/**
+ * @brief Plays random games from every empty cell through an Engine, and sets up random
+ * prefixes and continuations of them with Engine::setPosition, checking the evaluation
+ * after each change.
+ * @return The number of inconsistent positions, each of them printed.
+ */
+int verifyEngine(int cntGames, int cntPlies, std::mt19937 &rng,
+                 const EngineConfig &config) {
+    Engine engine(config);
+    int cntErrors = 0;
+    auto check = [&](int game, const char *step) {
+        if (engine.isConsistent()) return;
+        printf("engine game %d: inconsistent evaluation after %s of %d moves\n", game,
+               step, (int)engine.moves().size());
+        cntErrors++;
+    };
+
+    const int N = Board::BOARD_SIZE;
+    for (int game = 0; game < cntGames && !cntErrors; game++) {
+        engine.setPosition({});
+        for (int ply = 0; ply < cntPlies; ply++) {
+            // forbidden and occupied cells are refused, so give up on a crowded board
+            bool played = false;
+            for (int attempt = 0; attempt < 4 * N * N && !played; attempt++) {
+                played = engine.play({(int)(rng() % N), (int)(rng() % N)});
+            }
+            if (!played) break;
+            check(game, "play");
+        }
+
+        std::vector<Engine::Move> moves = engine.moves();
+        std::vector<Engine::Move> prefix(moves.begin(),
+                                         moves.begin() + rng() % (moves.size() + 1));
+        engine.setPosition(prefix);
+        check(game, "setPosition");
+        engine.setPosition(moves);
+        check(game, "setPosition");
+    }
+    return cntErrors;
+}
+
+/**
+ * @brief Plays the random games on a board of size N.
+ * @return The exit code.
+ */
+template <int N>
+int perft(int cntGames, int cntPlies, int verifyMode, std::mt19937 &rng,
+          EngineConfig config, const char *networkPath) {
+    Network network;
+    if (networkPath) {
+        if (!network.load<N>(networkPath)) {
+            fprintf(stderr, "Cannot load network %s\n", networkPath);
+            return 1;
+        }
+        config.network = &network;
+    }
+
+    BasicBoard<N> board;
+    BasicCore<N> core(&board, BoardBase::PIECE_COLOR::BLACK, config);
+    bool fVerify = verifyMode > 0;
+    bool fAnyCell = verifyMode == 2;
+
+    long long cntPairs = 0;
+    int cntErrors = 0;
+    double ms = 0;
+    std::vector<MoveGeneratorBase::Move> played;
+    std::vector<MoveGeneratorBase::Move> candidates;
+    for (int game = 0; game < cntGames && !cntErrors; game++) {
+        // pick the sequence beforehand so that only make/unmake is timed
+        played.clear();
+        int color = BoardBase::PIECE_COLOR::BLACK;
+        for (int ply = 0; ply < cntPlies; ply++) {
+            candidates.clear();
+            for (int x = 0; x < N; x++) {
+                for (int y = 0; y < N; y++) {
+                    MoveGeneratorBase::Move move = {x, y};
+                    bool legal = fAnyCell ? board.getState(x, y) == BoardBase::UNPLACE
+                                          : core.moveGenerator().existsMove(move);
+                    if (fAnyCell && color == BoardBase::PIECE_COLOR::BLACK &&
+                        core.moveGenerator().isForbidden(move)) {
+                        legal = false;
+                    }
+                    if (legal) candidates.push_back(move);
+                }
+            }
+            if (candidates.empty()) break;
+
+            MoveGeneratorBase::Move move = candidates[rng() % candidates.size()];
+            core.makeMove(move.x, move.y, static_cast<BoardBase::PIECE_COLOR>(color));
+            played.push_back(move);
+            color ^= 1;
+            if (fVerify) cntErrors += verify(core, &board, static_cast<BoardBase::PIECE_COLOR>(color));
+        }
+        for (auto it = played.rbegin(); it != played.rend(); ++it) {
+            core.cancelMove(it->x, it->y);
+            color ^= 1;
+            if (fVerify) cntErrors += verify(core, &board, static_cast<BoardBase::PIECE_COLOR>(color));
+        }
+        if (fVerify) continue;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        color = BoardBase::PIECE_COLOR::BLACK;
+        for (const MoveGeneratorBase::Move &move : played) {
+            core.makeMove(move.x, move.y, static_cast<BoardBase::PIECE_COLOR>(color));
+            color ^= 1;
+        }
+        for (auto it = played.rbegin(); it != played.rend(); ++it) {
+            core.cancelMove(it->x, it->y);
+        }
+        ms += std::chrono::duration<double, std::milli>(
+                  std::chrono::high_resolution_clock::now() - start)
+                  .count();
+        cntPairs += played.size();
+    }
+
+    if (fVerify && N == Board::BOARD_SIZE && !cntErrors) {
+        cntErrors += verifyEngine(cntGames, cntPlies, rng, config);
+    }
+    if (fVerify) {
+        printf("verified %d games of %d plies: %d errors\n", cntGames, cntPlies, cntErrors);
+        return cntErrors ? 1 : 0;
+    }
+    printf("make/unmake pairs: %lld\n", cntPairs);
+    printf("time: %.1f ms\n", ms);
+    printf("pairs per second: %.0f\n", ms > 0 ? cntPairs / ms * 1000 : 0.0);
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    int cntGames = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int cntPlies = argc > 2 ? std::atoi(argv[2]) : 60;
+    int verifyMode = argc > 3 ? std::atoi(argv[3]) : 0;
+    std::mt19937 rng(argc > 4 ? std::atoi(argv[4]) : 0);
+    int size = argc > 5 ? std::atoi(argv[5]) : Board::BOARD_SIZE;
+    EngineConfig config;
+    if (argc > 6 && !config.set("rule", argv[6])) {
+        fprintf(stderr, "Unknown rule %s\n", argv[6]);
+        return 1;
+    }
+    const char *networkPath = argc > 7 ? argv[7] : nullptr;
+
+    switch (size) {
+        case 15:
+            return perft<15>(cntGames, cntPlies, verifyMode, rng, config, networkPath);
+        case 19:
+            return perft<19>(cntGames, cntPlies, verifyMode, rng, config, networkPath);
+        case 20:
+            return perft<20>(cntGames, cntPlies, verifyMode, rng, config, networkPath);
+        default:
+            fprintf(stderr, "Unsupported board size %d\n", size);
+            return 1;
+    }
+}
@@ -0,0 +1,50 @@
+// Measures what a fresh process pays before its first move: constructing the Board
+// (Zobrist) and the Core (move generator, scorer and transposition table), and a first
+// shallow search that touches the transposition table.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "core.h"
+
+namespace {
+
+double elapsedUs(std::chrono::high_resolution_clock::time_point start) {
+    auto now = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::micro>(now - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 100;
+
+    EngineConfig config;
+    config.iterativeDeepening = false;
+    config.minSearchDepth = 4;
+
+    double constructUs = 0, searchUs = 0;
+    for (int r = 0; r < rounds; r++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        Board *pBoard = new Board();
+        pBoard->placeAt(7, 7, Board::PIECE_COLOR::BLACK);
+        Core *pCore = new Core(pBoard, Board::PIECE_COLOR::WHITE, config);
+        constructUs += elapsedUs(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        pCore->initTimer();
+        pCore->run();
+        searchUs += elapsedUs(start);
+
+        delete pCore;
+        delete pBoard;
+    }
+
+    std::cout << "rounds: " << rounds << "\n";
+    std::cout << "construct: " << constructUs / rounds << " us\n";
+    std::cout << "first search (depth " << config.minSearchDepth + 1
+              << "): " << searchUs / rounds << " us\n";
+    std::cout << "first move total: " << (constructUs + searchUs) / rounds << " us\n";
+    return 0;
+}
@@ -1,13 +1,96 @@
+#include <cstdlib>
 #include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "batch.h"
+#include "book.h"
+#include "config.h"
+#include "hash.h"
 #include "judger.h"
+#include "nnue.h"
+#include "server.h"
 
 int main(int argc, char* argv[]) {
-    Judger judger;
+    // options come last, after the mode and its arguments: --seed, --config and any
+    // EngineConfig setting by name
+    const char* configPath = nullptr;
+    std::vector<std::pair<std::string, std::string>> settings;
+    while (argc > 2 && std::strncmp(argv[argc - 2], "--", 2) == 0) {
+        if (std::strcmp(argv[argc - 2], "--seed") == 0) {
+            Zobrist::setSeed(std::strtoull(argv[argc - 1], nullptr, 0));
+        } else if (std::strcmp(argv[argc - 2], "--config") == 0) {
+            configPath = argv[argc - 1];
+        } else {
+            settings.insert(settings.begin(), {argv[argc - 2] + 2, argv[argc - 1]});
+        }
+        argc -= 2;
+    }
+
+    // flags override the config file
+    EngineConfig config;
+    std::string error;
+    if (configPath && !config.load(configPath, error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+    for (const auto& setting : settings) {
+        if (!config.set(setting.first, setting.second)) {
+            std::cerr << "Invalid option --" << setting.first << " " << setting.second
+                      << std::endl;
+            return 1;
+        }
+    }
+    if (!config.validate(error)) {
+        std::cerr << error << std::endl;
+        return 1;
+    }
+
+    // the book is validated against the keys, so it is opened after reseeding
+    Book book;
+    if (!config.bookPath.empty()) {
+        if (book.open<Board::BOARD_SIZE>(config.bookPath.c_str())) {
+            config.openingBook = &book;
+        } else {
+            std::cerr << "Cannot open book " << config.bookPath << std::endl;
+        }
+    }
+
+    Network network;
+    if (!config.networkPath.empty()) {
+        if (network.load<Board::BOARD_SIZE>(config.networkPath.c_str())) {
+            config.network = &network;
+        } else {
+            std::cerr << "Cannot load network " << config.networkPath << std::endl;
+        }
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "batch") == 0) {
+        if (argc > 2) config.threads = std::atoi(argv[2]);
+        if (argc > 3) config.timeLimit = std::atoi(argv[3]);
+        Batch(config).run(std::cin, std::cout);
+        return 0;
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "server") == 0) {
+        if (argc > 2) config.threads = std::atoi(argv[2]);
+        Server(config).run(std::cin, std::cout);
+        return 0;
+    }
 
+    Judger::MODE mode = Judger::MODE::COMMAND_LINE;
     if (argc > 1 && std::strcmp(argv[1], "json") == 0) {
-        Judger::JUDGER_MODE = Judger::MODE::ONLINE_JUDGE;
+        mode = Judger::MODE::ONLINE_JUDGE;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "keep") == 0) {
+        mode = Judger::MODE::KEEP_RUNNING;
     }
-    judger.startGame();
-    return 0;
-}
\ No newline at end of file
+    if (argc > 1 && std::strcmp(argv[1], "ponder") == 0) {
+        config.ponder = true;
+    }
+
+    Judger judger(mode, config);
+    return judger.startGame() ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+// Checks the free-style window type table generated at build time against table.out,
+// the table of whole line segments formerly generated by regular expressions and copied
+// into Scorer by hand. A segment lies between two blocks and must keep its type, which
+// is the strongest type of the windows through its pieces. Two fours in one line, which
+// table.out calls SLEEP_FOUR, are LIVE_FOUR now, since they cannot both be blocked; the
+// expected type of such a segment is worked out by placing a piece on each empty cell,
+// so every line of table.out is compared exactly.
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "scorer.h"
+
+namespace {
+
+const char *TYPE_NAMES[Scorer::CNT_TYPES] = {
+    "FIVE",       "LIVE_FOUR",   "KILL_1",   "KILL_2",    "SLEEP_FOUR", "LIVE_THREE",
+    "SLEEP_THREE", "LIVE_TWO", "SLEEP_TWO", "BASE",      "OVERLINE",   "DOUBLE_FOUR"};
+
+/**
+ * @brief Builds the window of a cell of a segment, blocked beyond both ends.
+ * @param cells The cells of the segment, '1' for a piece and '2' for an empty cell.
+ * @param center The index of the cell.
+ * @return The window, see Scorer::getTypeByWindow.
+ */
+int segmentWindow(const std::string &cells, int center) {
+    int window = 0;
+    for (int step = 1; step <= Scorer::WINDOW_SIDE; step++) {
+        if (center - step < 0) break;
+        window |= (cells[center - step] - '0') << 2 * (step - 1);
+    }
+    for (int step = 1; step <= Scorer::WINDOW_SIDE; step++) {
+        if (center + step >= (int)cells.size()) break;
+        window |= (cells[center + step] - '0') << 2 * (Scorer::WINDOW_SIDE + step - 1);
+    }
+    return window;
+}
+
+/**
+ * @brief Counts the cells of a segment that complete a five, or a longer line.
+ * @param cells The cells of the segment, '1' for a piece and '2' for an empty cell.
+ * @return The number of such cells.
+ */
+int countFivePoints(std::string cells) {
+    int cntFivePoints = 0;
+    for (char &cell : cells) {
+        if (cell != '2') continue;
+        cell = '1';
+        if (cells.find("11111") != std::string::npos) cntFivePoints++;
+        cell = '2';
+    }
+    return cntFivePoints;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    const char *path = argc > 1 ? argv[1] : TABLE_PATH;
+    std::ifstream fin(path);
+    if (!fin) {
+        std::cerr << "Cannot open " << path << std::endl;
+        return 1;
+    }
+
+    int cntLines = 0, cntDoubleFours = 0, cntMismatches = 0;
+    std::string line;
+    while (getline(fin, line)) {
+        std::istringstream sin(line);
+        std::string cells, type;
+        long long decimal;
+        int state;
+        if (!(sin >> cells >> decimal >> state >> type)) continue;
+
+        // the free-style types up to BASE are ordered from the strongest
+        Scorer::Type generated = Scorer::BASE;
+        for (int i = 0; i < (int)cells.size(); i++) {
+            if (cells[i] != '1') continue;
+            Scorer::Type t = Scorer::getTypeByWindow(segmentWindow(cells, i), false);
+            if (t < generated) generated = t;
+        }
+        std::string expected = type;
+        if (type == TYPE_NAMES[Scorer::SLEEP_FOUR] && countFivePoints(cells) > 1) {
+            expected = TYPE_NAMES[Scorer::LIVE_FOUR];
+            cntDoubleFours++;
+        }
+        if (expected != TYPE_NAMES[generated]) {
+            std::cout << "mismatch " << cells << " " << state << ": expected " << expected
+                      << ", got " << TYPE_NAMES[generated] << std::endl;
+            cntMismatches++;
+        }
+        cntLines++;
+    }
+
+    std::cout << cntLines << " segments, " << cntDoubleFours << " double fours, "
+              << cntMismatches << " mismatches" << std::endl;
+    return cntMismatches ? 1 : 0;
+}
@@ -0,0 +1,165 @@
+// Generates the window type tables of Scorer at build time, see Scorer::getTypeByWindow.
+// Writes a source file defining Scorer::WINDOW_TYPES, the free-style table followed by
+// the exact-five table, which the build compiles into libgomoku.
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "scorer.h"
+
+namespace {
+
+/**
+ * @brief The number of cells of a window with the move, the move in the middle.
+ */
+constexpr int LINE_LENGTH = 2 * Scorer::WINDOW_SIDE + 1;
+
+/**
+ * @brief The index of the move in the cells of a window.
+ */
+constexpr int CENTER = Scorer::WINDOW_SIDE;
+
+/**
+ * @brief Gets the bit offset of a cell in a window.
+ * @param i The index of the cell in the line, not CENTER.
+ */
+int cellShift(int i) {
+    return i < CENTER ? 2 * (CENTER - 1 - i) : 2 * (Scorer::WINDOW_SIDE + i - CENTER - 1);
+}
+
+/**
+ * @brief Classifies a window from the types of the windows with one more piece.
+ *
+ * A four is a line that one more piece makes a five through the move, a three one that
+ * one more piece makes a four and a two one that one more piece makes a three.
+ * @param window The window.
+ * @param exactFive Whether only exactly five in a row wins.
+ * @param table The types of the windows with more pieces.
+ * @return The type of the window.
+ */
+Scorer::Type classify(int window, bool exactFive, const unsigned char *table) {
+    int cells[LINE_LENGTH];
+    cells[CENTER] = 1;
+    for (int i = 0; i < LINE_LENGTH; i++) {
+        if (i != CENTER) cells[i] = window >> cellShift(i) & 3;
+    }
+
+    int lo = CENTER, hi = CENTER;
+    while (lo > 0 && cells[lo - 1] == 1) lo--;
+    while (hi < LINE_LENGTH - 1 && cells[hi + 1] == 1) hi++;
+    if (hi - lo + 1 == 5) return Scorer::FIVE;
+    if (hi - lo + 1 > 5) return exactFive ? Scorer::OVERLINE : Scorer::FIVE;
+
+    int cntFivePoints = 0, fivePoints[LINE_LENGTH];
+    bool liveFourPoint = false, fourPoint = false, liveThreePoint = false,
+         threePoint = false;
+    for (int i = 0; i < LINE_LENGTH; i++) {
+        if (cells[i] != 2) continue;
+        // empty (2) to the player's piece (1)
+        switch (table[window ^ 3 << cellShift(i)]) {
+            case Scorer::FIVE:
+                fivePoints[cntFivePoints++] = i;
+                break;
+            case Scorer::LIVE_FOUR:
+                liveFourPoint = true;
+                fourPoint = true;
+                break;
+            case Scorer::SLEEP_FOUR:
+            case Scorer::DOUBLE_FOUR:
+                fourPoint = true;
+                break;
+            case Scorer::LIVE_THREE:
+                liveThreePoint = true;
+                threePoint = true;
+                break;
+            case Scorer::SLEEP_THREE:
+                threePoint = true;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (cntFivePoints > 1) {
+        // an open four has its five points at both ends
+        if (!exactFive || (cntFivePoints == 2 && fivePoints[1] - fivePoints[0] == 5))
+            return Scorer::LIVE_FOUR;
+        return Scorer::DOUBLE_FOUR;
+    }
+    if (cntFivePoints == 1) return Scorer::SLEEP_FOUR;
+    if (liveFourPoint) return Scorer::LIVE_THREE;
+    if (fourPoint) return Scorer::SLEEP_THREE;
+    if (liveThreePoint) return Scorer::LIVE_TWO;
+    if (threePoint) return Scorer::SLEEP_TWO;
+    return Scorer::BASE;
+}
+
+/**
+ * @brief Fills a table of window types.
+ *
+ * Only windows whose cells beyond a blocked cell are blocked as well can occur. There
+ * are 63 such sides, so the 3969 windows are classified in decreasing order of pieces,
+ * each from the ones with one more piece.
+ * @param exactFive Whether only exactly five in a row wins.
+ * @param table The table to fill.
+ */
+void fillTable(bool exactFive, unsigned char *table) {
+    std::memset(table, Scorer::BASE, Scorer::CNT_WINDOWS);
+
+    std::vector<int> sides;
+    std::vector<int> sidePieces;
+    for (int length = 0; length <= Scorer::WINDOW_SIDE; length++) {
+        for (int bits = 0; bits < 1 << length; bits++) {
+            // bit k set for the player's piece at distance k + 1, empty otherwise
+            int side = 0, cntPieces = 0;
+            for (int k = 0; k < length; k++) {
+                side |= (bits >> k & 1 ? 1 : 2) << 2 * k;
+                cntPieces += bits >> k & 1;
+            }
+            sides.push_back(side);
+            sidePieces.push_back(cntPieces);
+        }
+    }
+
+    for (int cntPieces = 2 * Scorer::WINDOW_SIDE; cntPieces >= 0; cntPieces--) {
+        for (size_t l = 0; l < sides.size(); l++) {
+            for (size_t r = 0; r < sides.size(); r++) {
+                if (sidePieces[l] + sidePieces[r] != cntPieces) continue;
+                int window = sides[l] | sides[r] << 2 * Scorer::WINDOW_SIDE;
+                table[window] = classify(window, exactFive, table);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s output.cpp\n", argv[0]);
+        return 1;
+    }
+    FILE *file = fopen(argv[1], "w");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    static unsigned char tables[2][Scorer::CNT_WINDOWS];
+    fillTable(false, tables[0]);
+    fillTable(true, tables[1]);
+
+    fprintf(file, "// Generated by scoretable/generate.cpp, do not edit.\n\n");
+    fprintf(file, "#include \"scorer.h\"\n\n");
+    fprintf(file, "const unsigned char Scorer::WINDOW_TYPES[2][CNT_WINDOWS] = {\n");
+    for (int t = 0; t < 2; t++) {
+        fprintf(file, "{\n");
+        for (int window = 0; window < Scorer::CNT_WINDOWS; window++) {
+            fprintf(file, "%d,%s", tables[t][window], window % 64 == 63 ? "\n" : "");
+        }
+        fprintf(file, "},\n");
+    }
+    fprintf(file, "};\n");
+    return fclose(file) == 0 ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+#include "batch.h"
+
+#include <thread>
+#include <vector>
+
+#include "protocol.h"
+
+Batch::Batch(const EngineConfig &config) : m_config(config) {
+    if (m_config.threads < 1) m_config.threads = 1;
+}
+
+void Batch::run(std::istream &in, std::ostream &out) {
+    m_pIn = &in;
+    m_pOut = &out;
+    m_cntRead = m_cntWritten = 0;
+    m_pending.clear();
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < m_config.threads; i++) workers.emplace_back(&Batch::work, this);
+    for (auto &worker : workers) worker.join();
+    out.flush();
+}
+
+void Batch::work() {
+    // allocated once per worker; the core keeps pointing to the board between positions
+    Board board;
+    Core core(nullptr, Board::PIECE_COLOR::WHITE, m_config);
+
+    while (true) {
+        int id;
+        std::string line;
+        {
+            std::lock_guard<std::mutex> lock(m_inMutex);
+            if (!getline(*m_pIn, line)) return;
+            id = m_cntRead++;
+        }
+        output(id, line.empty() ? "" : evaluate(core, board, id, line));
+    }
+}
+
+std::string Batch::evaluate(Core &core, Board &board, int id,
+                            const std::string &line) const {
+    // take back the previous position, which also restores its hash and neighbour counts
+    for (int x = 0; x < Board::BOARD_SIZE; x++) {
+        for (int y = 0; y < Board::BOARD_SIZE; y++) {
+            if (board.getState(x, y) != Board::BOARD_STATE::UNPLACE) board.unplaceAt(x, y);
+        }
+    }
+
+    Board::PIECE_COLOR color;
+    if (!Protocol::readGame(line, &board, color)) {
+        return "{\"id\":" + std::to_string(id) + ",\"error\":\"invalid request\"}";
+    }
+
+    core.setBoard(&board, color);
+    core.initTimer();
+    int tm = core.run();
+
+    MoveGenerator::Move best = core.bestMove();
+    return "{\"id\":" + std::to_string(id) + ",\"response\":{\"x\":" +
+           std::to_string(best.x) + ",\"y\":" + std::to_string(best.y) +
+           "},\"score\":" + std::to_string(core.bestScore()) +
+           ",\"depth\":" + std::to_string(core.bestDepth()) +
+           ",\"nodes\":" + std::to_string(core.cntNodes()) +
+           ",\"time\":" + std::to_string(tm) + "}";
+}
+
+void Batch::output(int id, const std::string &result) {
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    m_pending[id] = result;
+    for (auto it = m_pending.begin(); it != m_pending.end() && it->first == m_cntWritten;
+         it = m_pending.erase(it), m_cntWritten++) {
+        if (!it->second.empty()) *m_pOut << it->second << "\n";
+    }
+    m_pOut->flush();
+}
@@ -0,0 +1,73 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "core.h"
+
+/**
+ * @class Batch
+ * @brief Evaluates a stream of positions given as Botzone requests, one JSON per line.
+ *
+ * Each worker thread owns one Core whose transposition table is reused across the
+ * positions it evaluates. The table is keyed by position, so its entries stay valid from
+ * one position to the next and are replaced as the table fills up.
+ */
+class Batch {
+   public:
+    /**
+     * @brief Constructs a Batch.
+     * @param config The settings of the workers' cores; threads is the number of
+     * workers and timeLimit the time limit of each search.
+     */
+    explicit Batch(const EngineConfig &config);
+
+    /**
+     * @brief Evaluates every position of the input.
+     *
+     * Writes one JSON line per position in input order, with the best move, score,
+     * completed depth, visited nodes and time, or an error for malformed lines. Empty
+     * lines are skipped.
+     * @param in The input stream.
+     * @param out The output stream.
+     */
+    void run(std::istream &in, std::ostream &out);
+
+   private:
+    /**
+     * @brief Evaluates positions until the input is exhausted.
+     */
+    void work();
+
+    /**
+     * @brief Evaluates a single position.
+     * @param core The core of the worker.
+     * @param board The board of the worker, which the core is set up on.
+     * @param id The line number of the position.
+     * @param line The Botzone request.
+     * @return The result line.
+     */
+    std::string evaluate(Core &core, Board &board, int id, const std::string &line) const;
+
+    /**
+     * @brief Stores a result and writes every result that is next in input order.
+     * @param id The line number of the position.
+     * @param result The result line, empty for skipped lines.
+     */
+    void output(int id, const std::string &result);
+
+    EngineConfig m_config;  ///< The settings of the workers' cores.
+
+    std::istream *m_pIn = nullptr;   ///< The input stream.
+    std::ostream *m_pOut = nullptr;  ///< The output stream.
+    std::mutex m_inMutex;            ///< Guards the input stream.
+    std::mutex m_outMutex;           ///< Guards the output stream and pending results.
+    int m_cntRead = 0;               ///< The number of lines read.
+    int m_cntWritten = 0;            ///< The number of lines whose result was written.
+    std::map<int, std::string> m_pending;  ///< Results waiting for earlier lines.
+};
+
+#endif
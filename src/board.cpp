@@ -4,10 +4,11 @@
 
 #include "hash.h"
 
-const int Board::dr[4] = {0, 1, 1, 1};
-const int Board::dc[4] = {1, 1, 0, -1};
+const int BoardBase::dr[4] = {0, 1, 1, 1};
+const int BoardBase::dc[4] = {1, 1, 0, -1};
 
-Board::Board() {
+template <int N>
+BasicBoard<N>::BasicBoard() {
     for (int i = 0; i < BOARD_SIZE; i++)
         for (int j = 0; j < BOARD_SIZE; j++) {
             m_boardState[i][j] = UNPLACE;
@@ -15,24 +16,27 @@ Board::Board() {
         }
 
     // initially we only consider moves in the center of the board
-    for (int i = 6; i <= 8; i++)
-        for (int j = 6; j <= 8; j++) {
+    for (int i = N / 2 - 1; i <= N / 2 + 1; i++)
+        for (int j = N / 2 - 1; j <= N / 2 + 1; j++) {
             m_cntNeighbour[i][j] = 1;
         }
 
-    m_pZobristHash = new Zobrist();
+    m_pZobristHash = new BasicZobrist<N>();
 }
 
-Board::~Board() { delete m_pZobristHash; }
+template <int N>
+BasicBoard<N>::~BasicBoard() { delete m_pZobristHash; }
 
-Board::BOARD_STATE Board::getState(int x, int y) const {
+template <int N>
+BoardBase::BOARD_STATE BasicBoard<N>::getState(int x, int y) const {
     if (x < 0 || x >= BOARD_SIZE || y < 0 || y >= BOARD_SIZE) {
         return BOARD_STATE::INVALID;
     }
     return m_boardState[x][y];
 }
 
-void Board::display() const {
+template <int N>
+void BasicBoard<N>::display() const {
     std::cout << "  ";
     for (int i = 0; i < BOARD_SIZE; i++)
         std::cout << char(i < 10 ? (int)i + '0' : 'A' + (int)i - 10) << " ";
@@ -49,7 +53,8 @@ void Board::display() const {
     }
 }
 
-void Board::placeAt(int x, int y, Board::PIECE_COLOR color) {
+template <int N>
+void BasicBoard<N>::placeAt(int x, int y, PIECE_COLOR color) {
     m_boardState[x][y] = static_cast<BOARD_STATE>(color);
     m_pZobristHash->update(x, y, color);
 
@@ -74,9 +79,10 @@ void Board::placeAt(int x, int y, Board::PIECE_COLOR color) {
     }
 }
 
-void Board::unplaceAt(int x, int y) {
+template <int N>
+void BasicBoard<N>::unplaceAt(int x, int y) {
     m_pZobristHash->update(x, y, static_cast<PIECE_COLOR>(m_boardState[x][y]));
-    m_boardState[x][y] = Board::BOARD_STATE::UNPLACE;
+    m_boardState[x][y] = BOARD_STATE::UNPLACE;
 
     for (int k = 0; k < 4; k++) {
         int tx = x;
@@ -99,4 +105,15 @@ void Board::unplaceAt(int x, int y) {
     }
 }
 
-unsigned long long Board::getBoardHash() const { return m_pZobristHash->getBoardHash(); }
\ No newline at end of file
+template <int N>
+unsigned long long BasicBoard<N>::getBoardHash() const {
+    return m_pZobristHash->getBoardHash();
+}
+
+template <int N>
+unsigned long long BasicBoard<N>::getCanonicalHash(int &symmetry) const {
+    return m_pZobristHash->getCanonicalHash(symmetry);
+}
+
+#define INSTANTIATE(N) template class BasicBoard<N>;
+GOMOKU_FOR_EACH_BOARD_SIZE(INSTANTIATE)
@@ -1,17 +1,20 @@
 #ifndef BOARD_H
 #define BOARD_H
 
-class Zobrist;
+template <int N>
+class BasicZobrist;
 
 /**
- * @class Board
- * @brief Represents a game board for Gomoku.
- *
- * The Board class provides functionality to manage and manipulate the game board.
- * It keeps track of the state of each cell on the board and provides methods to
- * place and remove pieces, retrieve the state of a cell, and display the board.
+ * @brief Instantiates a template for every supported board size.
+ * @param X A macro taking the board size.
  */
-class Board {
+#define GOMOKU_FOR_EACH_BOARD_SIZE(X) X(15) X(19) X(20)
+
+/**
+ * @class BoardBase
+ * @brief The parts of a game board that do not depend on its size.
+ */
+class BoardBase {
    public:
     /**
      * @enum PIECE_COLOR
@@ -34,14 +37,46 @@ class Board {
     };
 
     /**
-     * @brief Default constructor for the Board class.
+     * @brief The size of the standard game board.
+     */
+    const static int DEFAULT_SIZE = 15;
+
+    /**
+     * @brief The row offsets for neighboring cells.
+     */
+    const static int dr[4];
+
+    /**
+     * @brief The column offsets for neighboring cells.
+     */
+    const static int dc[4];
+};
+
+/**
+ * @class BasicBoard
+ * @brief Represents a game board for Gomoku.
+ *
+ * The BasicBoard class provides functionality to manage and manipulate the game board.
+ * It keeps track of the state of each cell on the board and provides methods to
+ * place and remove pieces, retrieve the state of a cell, and display the board.
+ *
+ * @tparam N The size of the board.
+ */
+template <int N>
+class BasicBoard : public BoardBase {
+   public:
+    /**
+     * @brief Default constructor for the BasicBoard class.
      */
-    Board();
+    BasicBoard();
 
     /**
-     * @brief Destructor for the Board class.
+     * @brief Destructor for the BasicBoard class.
      */
-    ~Board();
+    ~BasicBoard();
+
+    BasicBoard(const BasicBoard &) = delete;
+    BasicBoard &operator=(const BasicBoard &) = delete;
 
     /**
      * @brief Displays the current state of the board.
@@ -91,26 +126,30 @@ class Board {
     unsigned long long getBoardHash() const;
 
     /**
-     * @brief The size of the game board.
+     * @brief Gets the hash value shared by the board and all its symmetric images.
+     * @param symmetry Set to the symmetry mapping the board to its canonical image, see
+     * BasicZobrist::transform.
+     * @return The canonical hash value of the board.
      */
-    const static int BOARD_SIZE = 15;
+    unsigned long long getCanonicalHash(int &symmetry) const;
 
     /**
-     * @brief The row offsets for neighboring cells.
-     */
-    const static int dr[4];
-
-    /**
-     * @brief The column offsets for neighboring cells.
+     * @brief The size of the game board.
      */
-    const static int dc[4];
+    const static int BOARD_SIZE = N;
 
    private:
-    Zobrist *m_pZobristHash = nullptr; /**< Pointer to the Zobrist hash generator */
+    BasicZobrist<N> *m_pZobristHash = nullptr; /**< Pointer to the Zobrist hash
+                                                  generator */
     BOARD_STATE m_boardState[BOARD_SIZE]
                             [BOARD_SIZE]; /**< The state of each cell on the board */
     int m_cntNeighbour[BOARD_SIZE][BOARD_SIZE]; /**< The number of neighboring game pieces
                                                    for each cell */
 };
 
-#endif
\ No newline at end of file
+/**
+ * @brief The standard 15x15 game board.
+ */
+using Board = BasicBoard<BoardBase::DEFAULT_SIZE>;
+
+#endif
@@ -0,0 +1,76 @@
+#include "book.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "hash.h"
+
+const char Book::MAGIC[8] = {'G', 'M', 'K', 'B', 'O', 'O', 'K', '\0'};
+
+Book::~Book() {
+    if (m_pData) munmap(m_pData, m_length);
+}
+
+template <int N>
+bool Book::open(const char *path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+    void *pData = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pData == MAP_FAILED) return false;
+
+    const Header *pHeader = static_cast<const Header *>(pData);
+    if (std::memcmp(pHeader->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        pHeader->version != VERSION || pHeader->boardSize != N ||
+        pHeader->keyCheck != BasicZobrist<N>::checksum() ||
+        pHeader->cntEntries > (st.st_size - sizeof(Header)) / sizeof(Entry)) {
+        munmap(pData, st.st_size);
+        return false;
+    }
+
+    if (m_pData) munmap(m_pData, m_length);
+    m_pData = pData;
+    m_length = st.st_size;
+    m_pEntries = reinterpret_cast<const Entry *>(pHeader + 1);
+    m_cntEntries = pHeader->cntEntries;
+    m_boardSize = N;
+    return true;
+}
+
+template <int N>
+bool Book::find(const BasicBoard<N> &board, MoveGeneratorBase::Move &move) const {
+    if (!m_cntEntries || m_boardSize != N) return false;
+
+    int symmetry;
+    uint64_t key = board.getCanonicalHash(symmetry);
+    const Entry *pEnd = m_pEntries + m_cntEntries;
+    const Entry *pEntry = std::lower_bound(
+        m_pEntries, pEnd, key, [](const Entry &entry, uint64_t k) { return entry.key < k; });
+
+    const Entry *pBest = nullptr;
+    for (; pEntry != pEnd && pEntry->key == key; pEntry++) {
+        if (!pBest || pEntry->weight > pBest->weight) pBest = pEntry;
+    }
+    if (!pBest) return false;
+
+    move = {pBest->x, pBest->y};
+    BasicZobrist<N>::inverseTransform(move.x, move.y, symmetry);
+    // guards against hash collisions
+    return board.getState(move.x, move.y) == BoardBase::UNPLACE;
+}
+
+#define INSTANTIATE(N)                                 \
+    template bool Book::open<N>(const char *path); \
+    template bool Book::find<N>(const BasicBoard<N> &, MoveGeneratorBase::Move &) const;
+GOMOKU_FOR_EACH_BOARD_SIZE(INSTANTIATE)
@@ -0,0 +1,102 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "board.h"
+#include "generator.h"
+
+/**
+ * @class Book
+ * @brief A read-only opening book, memory-mapped from a file.
+ *
+ * The file is a Header followed by Entry records sorted by key. Keys are canonical
+ * hashes (see Board::getCanonicalHash), with the move stored in the orientation of the
+ * canonical image. Transposed and mirrored positions thus share an entry.
+ */
+class Book {
+   public:
+    /**
+     * @struct Header
+     * @brief The header of a book file.
+     */
+    struct Header {
+        char magic[8];          /**< "GMKBOOK" followed by a zero byte. */
+        uint32_t version;       /**< The file format version. */
+        uint32_t boardSize;     /**< The board size the book was built for. */
+        uint64_t keyCheck;      /**< Zobrist::checksum() of the keys the book was built
+                                   with. */
+        uint64_t cntEntries;    /**< The number of entries. */
+    };
+
+    /**
+     * @struct Entry
+     * @brief A book move.
+     */
+    struct Entry {
+        uint64_t key;     /**< The canonical key of the position. */
+        uint8_t x;        /**< The x-coordinate of the move in the canonical image. */
+        uint8_t y;        /**< The y-coordinate of the move in the canonical image. */
+        uint16_t weight;  /**< The preference among moves of the same position. */
+        uint32_t padding; /**< Unused, zero. */
+    };
+
+    /**
+     * @brief Default constructor for Book.
+     */
+    Book() = default;
+
+    /**
+     * @brief Destructor for Book, unmapping the file.
+     */
+    ~Book();
+
+    Book(const Book &) = delete;
+    Book &operator=(const Book &) = delete;
+
+    /**
+     * @brief Maps a book file.
+     * @tparam N The size of the board the book is for.
+     * @param path The path of the file.
+     * @return True if the file is a valid book for this board size and the current
+     * Zobrist keys, false otherwise.
+     */
+    template <int N>
+    bool open(const char *path);
+
+    /**
+     * @brief Looks up the move with the highest weight for a position.
+     * @param board The position.
+     * @param move Set to the book move, mapped back to the orientation of the board.
+     * @return True if the position is in the book and its move is playable, false
+     * otherwise or if the book is for another board size.
+     */
+    template <int N>
+    bool find(const BasicBoard<N> &board, MoveGeneratorBase::Move &move) const;
+
+    /**
+     * @brief Gets the number of entries.
+     * @return The number of entries.
+     */
+    size_t size() const { return m_cntEntries; }
+
+    /**
+     * @brief The magic bytes of a book file.
+     */
+    static const char MAGIC[8];
+
+    /**
+     * @brief The file format version.
+     */
+    const static uint32_t VERSION = 2;
+
+   private:
+    void *m_pData = nullptr;          /**< The mapped file. */
+    size_t m_length = 0;              /**< The length of the mapping. */
+    const Entry *m_pEntries = nullptr; /**< The sorted entries. */
+    size_t m_cntEntries = 0;          /**< The number of entries. */
+    int m_boardSize = 0;              /**< The board size of the book. */
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "config.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+
+namespace {
+
+/**
+ * @brief Parses a whole string as an integer in [min, max].
+ * @return False if the string is not an integer or out of range.
+ */
+bool parseInt(const std::string &value, int &result, int min, int max = INT_MAX) {
+    char *end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0' || errno == ERANGE) return false;
+    if (parsed < min || parsed > max) return false;
+    result = static_cast<int>(parsed);
+    return true;
+}
+
+bool parseFlag(const std::string &value, bool &result) {
+    if (value != "0" && value != "1") return false;
+    result = value == "1";
+    return true;
+}
+
+std::string trim(const std::string &s) {
+    size_t begin = s.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) return "";
+    return s.substr(begin, s.find_last_not_of(" \t\r") + 1 - begin);
+}
+
+}  // namespace
+
+bool EngineConfig::set(const std::string &key, const std::string &value) {
+    if (key == "min-depth") return parseInt(value, minSearchDepth, 1);
+    if (key == "max-depth") return parseInt(value, maxSearchDepth, 1);
+    if (key == "kill-depth") return parseInt(value, killDepth, 0);
+    if (key == "iterative-deepening") return parseFlag(value, iterativeDeepening);
+    if (key == "branch") return parseInt(value, branchFactor, 1);
+    if (key == "score-cut") return parseInt(value, scoreCutRatio, 0);
+    if (key == "black-weight") return parseInt(value, blackWeight, 0);
+    if (key == "time") return parseInt(value, timeLimit, 1);
+    if (key == "ponder") return parseFlag(value, ponder);
+    if (key == "threads") return parseInt(value, threads, 1);
+    if (key == "hash") return parseInt(value, hashSize, 1);
+    if (key == "tt-file-depth") return parseInt(value, ttFileDepth, 0);
+
+    if (key == "rule") {
+        if (value == "freestyle") {
+            rule = Rule::FREESTYLE;
+        } else if (value == "standard") {
+            rule = Rule::STANDARD;
+        } else if (value == "renju") {
+            rule = Rule::RENJU;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    if (key == "tt-file") {
+        ttFile = value;
+    } else if (key == "book") {
+        bookPath = value;
+    } else if (key == "nnue") {
+        networkPath = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool EngineConfig::load(const char *path, std::string &error) {
+    std::ifstream fin(path);
+    if (!fin) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+
+    std::string line;
+    for (int lineNumber = 1; getline(fin, line); lineNumber++) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        size_t eq = line.find('=');
+        std::string key = eq == std::string::npos ? "" : trim(line.substr(0, eq));
+        std::string value = eq == std::string::npos ? "" : trim(line.substr(eq + 1));
+        if (!set(key, value)) {
+            error = std::string(path) + ":" + std::to_string(lineNumber) +
+                    ": invalid setting \"" + line + "\"";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EngineConfig::validate(std::string &error) const {
+    if (minSearchDepth > maxSearchDepth) {
+        error = "min-depth " + std::to_string(minSearchDepth) + " exceeds max-depth " +
+                std::to_string(maxSearchDepth);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <string>
+
+#include "rule.h"
+#include "weights.h"
+
+class Book;
+class Network;
+
+/**
+ * @struct EngineConfig
+ * @brief The settings of one engine: search, time control, resources and rules.
+ *
+ * Every Core keeps its own copy, so engines with different settings can run side by side
+ * in one process. The settings can be set by name with set(), from command-line flags or
+ * a config file of "key = value" lines (see load()).
+ */
+struct EngineConfig {
+    /**
+     * @brief The number of remaining depths covered by the branch factor table.
+     */
+    const static int BRANCH_TABLE_DEPTH = 12;
+
+    int minSearchDepth = 4;          /**< min-depth: the first iterative deepening depth,
+                                        or the only depth without it. */
+    int maxSearchDepth = 10;         /**< max-depth: the last iterative deepening depth. */
+    int killDepth = 4;               /**< kill-depth: added to the win scores, so that
+                                        nearer wins score higher. */
+    bool iterativeDeepening = true;  /**< iterative-deepening: 0 searches minSearchDepth
+                                        once, 1 deepens until the time is up. */
+    int branchFactor = 25;           /**< branch: the upper bound of the branch factor. */
+    int scoreCutRatio = 100;         /**< score-cut: moves scoring below the best move's
+                                        score divided by it are not searched, 0 keeps
+                                        them all. */
+    int blackWeight = GOMOKU_BLACK_WEIGHT; /**< black-weight: the weight of black's score
+                                              against white's in the evaluation. */
+
+    /**
+     * @brief The branch factor by node type (see CoreBase::NodeType) and remaining
+     * depth. Deeper remaining depths use the last column.
+     */
+    int branchFactors[3][BRANCH_TABLE_DEPTH] = {
+        // narrow near the leaves, wide near the root; nodes expected to fail high only
+        // need their few best moves
+        {0, 12, 15, 18, 20, 22, 25, 25, 25, 25, 25, 25},  // PV_NODE
+        {0, 8, 10, 12, 14, 16, 18, 20, 20, 20, 20, 20},   // CUT_NODE
+        {0, 10, 12, 14, 16, 18, 20, 22, 22, 22, 22, 22},  // ALL_NODE
+    };
+
+    int timeLimit = 5900;  /**< time: the time limit of a search in milliseconds. */
+    bool ponder = false;   /**< ponder: whether the command-line game searches on the
+                              opponent's time. */
+
+    int threads = 1;       /**< threads: the number of worker threads of batch mode and
+                              self-play. */
+    int hashSize = 48;     /**< hash: the size of the TT in megabytes, rounded down to a
+                              power of two entries. */
+
+    Rule::TYPE rule = Rule::FREESTYLE; /**< rule: freestyle, standard or renju. */
+
+    std::string ttFile;    /**< tt-file: the file the TT is loaded from when a Core is
+                              constructed and saved to by saveTT(), empty for none. */
+    int ttFileDepth = 3;   /**< tt-file-depth: the minimum search depth of the TT entries
+                              saved to ttFile. */
+    std::string bookPath;  /**< book: the opening book file, loaded by the caller into
+                              openingBook. */
+    std::string networkPath; /**< nnue: the network weight file, loaded by the caller
+                                into network. */
+
+    const Book *openingBook = nullptr; /**< The opening book consulted before searching,
+                                          or nullptr for none. */
+    const Network *network = nullptr;  /**< The network evaluating the searched positions
+                                          instead of the pattern scores, or nullptr.
+                                          Only cores of its board size use it. */
+
+    /**
+     * @brief Sets a setting by the name in its documentation.
+     * @param key The name of the setting.
+     * @param value The value, a number, 0 or 1 for flags, or a name or path.
+     * @return False if the key is unknown or the value invalid or out of range.
+     */
+    bool set(const std::string &key, const std::string &value);
+
+    /**
+     * @brief Reads settings from a file of "key = value" lines. Empty lines and lines
+     * starting with '#' are skipped.
+     * @param path The path of the file.
+     * @param error Receives a description of the first error.
+     * @return False if the file cannot be read or a line is invalid.
+     */
+    bool load(const char *path, std::string &error);
+
+    /**
+     * @brief Checks the settings against each other, such as min-depth against
+     * max-depth. Call it once every setting is set, since they may come in any order.
+     * @param error Receives a description of the first error.
+     * @return False if the settings contradict each other.
+     */
+    bool validate(std::string &error) const;
+};
+
+#endif
@@ -1,41 +1,112 @@
 #include "core.h"
 
+#include <cmath>
+#include <iostream>
+
 #define min(a, b) ((a) <= (b) ? (a) : (b))
 #define max(a, b) ((a) >= (b) ? (a) : (b))
 
-bool Core::ITERATIVE_DEEPENING = true;
-int Core::BRANCH_FACTOR = 25;
-int Core::MIN_SEARCH_DEPTH = 4;
-int Core::MAX_SEARCH_DEPTH = 10;
-int Core::KILL_DEPTH = 4;
+template <int N>
+BasicCore<N>::BasicCore(BasicBoard<N> *pBoard, BoardBase::PIECE_COLOR color,
+                        const EngineConfig &config)
+    : CoreBase(config),
+      m_pBoard(pBoard),
+      m_TT(TT::bitsForSize(config.hashSize)),
+      m_moveGenerator(config.rule),
+      m_color(color) {
+    if (!m_config.ttFile.empty()) m_TT.load<N>(m_config.ttFile.c_str(), ttSignature());
+    initWindowTypes();
+    if (!pBoard) return;
+
+    initMoves(m_moveGenerator, &m_windows);
+    initNetwork();
+}
 
-Core::Core(Board *pBoard, Board::PIECE_COLOR color) : m_pBoard(pBoard), m_color(color) {
+template <int N>
+void BasicCore<N>::setBoard(BasicBoard<N> *pBoard, BoardBase::PIECE_COLOR color) {
+    m_pBoard = pBoard;
+    m_color = color;
+    m_moveGenerator = BasicMoveGenerator<N>(m_config.rule);
+    initWindowTypes();
     if (!pBoard) return;
 
-    for (int i = 0; i < Board::BOARD_SIZE; ++i) {
-        for (int j = 0; j < Board::BOARD_SIZE; ++j) {
+    initMoves(m_moveGenerator, &m_windows);
+    initNetwork();
+}
+
+template <int N>
+void BasicCore<N>::initMoves(BasicMoveGenerator<N> &generator, Windows *pWindows) const {
+    const BasicBoard<N> *pBoard = m_pBoard;
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
             // only consider the points around the placed points
-            if (pBoard->getState(i, j) == Board::UNPLACE &&
+            if (pBoard->getState(i, j) == BoardBase::UNPLACE &&
                 pBoard->cntNeighbour(i, j) > 0) {
-                m_moveGenerator.addMove({i, j});
-                updateMoveAt(i, j, Board::PIECE_COLOR::BLACK);
-                updateMoveAt(i, j, Board::PIECE_COLOR::WHITE);
+                generator.addMove({i, j});
+            }
+        }
+    }
+
+    // the scores do not depend on the order in which the directions are set
+    BasicLineScanner<N> scanner;
+    for (int c = 0; c < 2; c++) {
+        BoardBase::PIECE_COLOR player = static_cast<BoardBase::PIECE_COLOR>(c);
+        scanner.scan(*pBoard, player);
+        if (pWindows) {
+            for (int dir = 0; dir < 4; dir++) {
+                for (int i = 0; i < N; i++) {
+                    for (int j = 0; j < N; j++) {
+                        (*pWindows)[player][dir][i][j] = scanner.lineWindow(i, j, dir);
+                    }
+                }
             }
         }
+        for (const Move &move : generator.m_moves) {
+            for (int dir = 0; dir < 4; dir++) {
+                int window = scanner.lineWindow(move.x, move.y, dir);
+                generator.updateMoveScoreByDir(
+                    move, dir, static_cast<Scorer::Type>(m_windowTypes[player][window]),
+                    player);
+            }
+        }
+    }
+}
+
+template <int N>
+BasicCore<N>::~BasicCore() {
+    if (m_ponderThread.joinable()) {
+        m_stop = true;
+        m_ponderThread.join();
     }
 }
 
-int Core::negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int beta) {
+int CoreBase::branchFactor(int depth, NodeType nodeType) const {
+    int column = min(depth, EngineConfig::BRANCH_TABLE_DEPTH - 1);
+    int factor = m_config.branchFactors[nodeType][column];
+    return min(factor, m_config.branchFactor);
+}
+
+template <int N>
+int BasicCore<N>::negMiniMaxSearch(int depth, BoardBase::PIECE_COLOR player, int alpha,
+                                   int beta, NodeType nodeType) {
+    m_cntNodes++;
+
     if (depth == 0) {
+        STATS(m_stats.leaves++;)
         int val = evaluate();
         m_TT.insert(m_pBoard->getBoardHash(), depth, val, TT::EXACT, player);
         return val;
     }
 
-    if (m_timer.getTimePass() >= TIME_LIMIT) {
+    if (m_stop || (!m_infinite && m_timer.getTimePass() >= m_config.timeLimit)) {
         return Timer::TIME_OUT;
     }
 
+    // remember the best reply of each root move as the move to ponder on
+    if (depth == iterativeDepth - 1) {
+        m_replyCandidate = {-1, -1};
+    }
+
     if (depth != iterativeDepth) {
         int val = m_TT.find(m_pBoard->getBoardHash(), depth, alpha, beta, player);
         if (val != TT::TT_NOT_HIT) {
@@ -45,10 +116,15 @@ int Core::negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int
 
     TT::Flag flag = TT::UPPER;
 
-    std::vector<MoveGenerator::Move> moves =
-        m_moveGenerator.generateMovesList(BRANCH_FACTOR);
+    std::vector<Move> moves =
+        m_moveGenerator.generateMovesList(branchFactor(depth, nodeType),
+                                          m_config.scoreCutRatio);
     int cntMoves = moves.size();
-    Board::PIECE_COLOR opponent = static_cast<Board::PIECE_COLOR>(player ^ 1);
+    BoardBase::PIECE_COLOR opponent = static_cast<BoardBase::PIECE_COLOR>(player ^ 1);
+
+    // a cut node's children are expected to fail low and vice versa
+    NodeType nullWindowType = nodeType == CUT_NODE ? ALL_NODE : CUT_NODE;
+    NodeType fullWindowType = nodeType == PV_NODE ? PV_NODE : nullWindowType;
 
     bool opponentHasFive = false;
     int i = 0;
@@ -62,11 +138,15 @@ int Core::negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int
         int playerMoveScore = m_moveGenerator.playerMoveScore(move, player);
         if (playerMoveScore >= Scorer::TYPE_SCORES[Scorer::FIVE]) {
             // win
-            int val = INF + depth + KILL_DEPTH;
+            int val = INF + depth + m_config.killDepth;
 
             if (depth == iterativeDepth && val > m_bestScore) {
                 m_bestMove = move;
                 m_bestScore = val;
+                m_ponderMove = {-1, -1};
+            }
+            if (depth == iterativeDepth - 1 && val > alpha) {
+                m_replyCandidate = move;
             }
             if (val >= beta) {
                 m_TT.insert(m_pBoard->getBoardHash(), depth, beta, TT::LOWER, player);
@@ -90,17 +170,28 @@ int Core::negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int
 
         auto &move = moves[i];
 
-        makeMove(move.x, move.y, player);
-        int val = -negMiniMaxSearch(depth - 1, opponent, -beta, -alpha);
-        cancelMove(move.x, move.y);
+        int val;
+        if (player == BoardBase::BLACK && m_moveGenerator.isForbidden(move)) {
+            // the only block is forbidden, the opponent's five follows
+            val = -(INF + depth - 1 + m_config.killDepth);
+        } else {
+            makeMove(move.x, move.y, player);
+            val = -negMiniMaxSearch(depth - 1, opponent, -beta, -alpha, fullWindowType);
+            cancelMove(move.x, move.y);
 
-        if (val == -Timer::TIME_OUT) return Timer::TIME_OUT;
+            if (val == -Timer::TIME_OUT) return Timer::TIME_OUT;
+        }
 
         if (depth == iterativeDepth && val > m_bestScore) {
             m_bestMove = move;
             m_bestScore = val;
+            m_ponderMove = m_replyCandidate;
+        }
+        if (depth == iterativeDepth - 1 && val > alpha) {
+            m_replyCandidate = move;
         }
         if (val >= beta) {
+            STATS(m_stats.cutoffs++; m_stats.firstMoveCutoffs++;)
             m_TT.insert(m_pBoard->getBoardHash(), depth, beta, TT::LOWER, player);
             return val;
         }
@@ -110,19 +201,31 @@ int Core::negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int
         }
     } else {
         bool fFoundPv = false;
+        // skipped candidates do not count, so that the first searched move is the first
+        STATS(int cntSearched = 0;)
         while (i < cntMoves) {
             auto &move = moves[i];
 
+            if (player == BoardBase::BLACK && m_moveGenerator.isForbidden(move)) {
+                i++;
+                continue;
+            }
+            STATS(cntSearched++;)
+
             int val = alpha;
 
             if (m_moveGenerator.playerMoveScore(move, player) >=
                 Scorer::TYPE_SCORES[Scorer::KILL_1]) {
                 // since opponent has no FIVE, we can win
-                val = INF + depth + KILL_DEPTH - 1;
+                val = INF + depth + m_config.killDepth - 1;
 
                 if (depth == iterativeDepth && val > m_bestScore) {
                     m_bestMove = move;
                     m_bestScore = val;
+                    m_ponderMove = {-1, -1};
+                }
+                if (depth == iterativeDepth - 1 && val > alpha) {
+                    m_replyCandidate = move;
                 }
                 if (val >= beta) {
                     m_TT.insert(m_pBoard->getBoardHash(), depth, beta, TT::LOWER, player);
@@ -138,12 +241,15 @@ int Core::negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int
             } else {
                 makeMove(move.x, move.y, player);
                 if (fFoundPv) {
-                    val = -negMiniMaxSearch(depth - 1, opponent, -alpha - 1, -alpha);
+                    val = -negMiniMaxSearch(depth - 1, opponent, -alpha - 1, -alpha,
+                                            nullWindowType);
                     if ((val > alpha) && (val < beta)) {
-                        val = -negMiniMaxSearch(depth - 1, opponent, -beta, -alpha);
+                        val = -negMiniMaxSearch(depth - 1, opponent, -beta, -alpha,
+                                                fullWindowType);
                     }
                 } else {
-                    val = -negMiniMaxSearch(depth - 1, opponent, -beta, -alpha);
+                    val = -negMiniMaxSearch(depth - 1, opponent, -beta, -alpha,
+                                            fullWindowType);
                 }
                 cancelMove(move.x, move.y);
                 if (val == -Timer::TIME_OUT) return Timer::TIME_OUT;
@@ -152,8 +258,14 @@ int Core::negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int
             if (depth == iterativeDepth && val > m_bestScore) {
                 m_bestMove = move;
                 m_bestScore = val;
+                m_ponderMove = m_replyCandidate;
+            }
+            if (depth == iterativeDepth - 1 && val > alpha) {
+                m_replyCandidate = move;
             }
             if (val >= beta) {
+                STATS(m_stats.cutoffs++;
+                      if (cntSearched == 1) m_stats.firstMoveCutoffs++;)
                 m_TT.insert(m_pBoard->getBoardHash(), depth, beta, TT::LOWER, player);
                 return val;
             }
@@ -171,231 +283,325 @@ int Core::negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int
     return alpha;
 }
 
-int Core::run() {
+template <int N>
+int BasicCore<N>::run() {
     if (!m_pBoard) return -1;
 
     // if core is white, we search for odd depth, so that evaluation is done at black
     // player's point of view
-    iterativeDepth = MIN_SEARCH_DEPTH + 1 - m_color;
+    iterativeDepth = m_config.minSearchDepth + 1 - m_color;
+    m_cntNodes = 0;
+    m_bestDepth = 0;
+    STATS(m_stats = SearchStats(); m_TT.resetStats();)
+
+    Move bookMove;
+    if (m_config.openingBook && m_config.openingBook->find(*m_pBoard, bookMove) &&
+        !(m_color == BoardBase::BLACK && m_moveGenerator.isForbidden(bookMove))) {
+        m_bestMove = bookMove;
+        m_ponderMove = {-1, -1};
+        m_bestScore = 0;
+        return m_timer.getTimePass();
+    }
 
-    if (ITERATIVE_DEEPENING) {
+    if (m_config.iterativeDeepening) {
         m_bestMove = {-1, -1};
+        m_ponderMove = {-1, -1};
         int prevBestScore = -__INT32_MAX__;
-        MoveGenerator::Move prevBestMove = {-1, -1};
-        for (; iterativeDepth <= MAX_SEARCH_DEPTH + 1 - m_color; iterativeDepth += 2) {
+        Move prevBestMove = {-1, -1};
+        Move prevPonderMove = {-1, -1};
+        int maxDepth = m_config.maxSearchDepth + 1 - m_color;
+        for (; iterativeDepth <= maxDepth; iterativeDepth += 2) {
             m_bestScore = -__INT32_MAX__;
+            STATS(long long startNodes = m_cntNodes; int startTime = m_timer.getTimePass();)
             int val = negMiniMaxSearch(iterativeDepth, m_color,
-                                       -INF - iterativeDepth - KILL_DEPTH,
-                                       INF + iterativeDepth + KILL_DEPTH);
+                                       -INF - iterativeDepth - m_config.killDepth,
+                                       INF + iterativeDepth + m_config.killDepth,
+                                       PV_NODE);
+            STATS(recordIteration(m_cntNodes - startNodes, m_timer.getTimePass() - startTime,
+                                  val != Timer::TIME_OUT);)
             if (val == Timer::TIME_OUT) {
-                m_bestScore = prevBestScore;
-                m_bestMove = prevBestMove;
+                // an unfinished first iteration still beats having no move at all
+                if (prevBestMove.x != -1) {
+                    m_bestScore = prevBestScore;
+                    m_bestMove = prevBestMove;
+                    m_ponderMove = prevPonderMove;
+                }
                 break;
-            } else if (val >= INF) {
+            }
+            m_bestDepth = iterativeDepth;
+            if (val >= INF) {
                 break;
             }
             prevBestScore = m_bestScore;
             prevBestMove = m_bestMove;
+            prevPonderMove = m_ponderMove;
         }
     } else {
         m_bestMove = {-1, -1};
+        m_ponderMove = {-1, -1};
         m_bestScore = -__INT32_MAX__;
-        negMiniMaxSearch(iterativeDepth, m_color, -INF - iterativeDepth - KILL_DEPTH,
-                         INF + iterativeDepth + KILL_DEPTH);
+        int val = negMiniMaxSearch(iterativeDepth, m_color,
+                                   -INF - iterativeDepth - m_config.killDepth,
+                                   INF + iterativeDepth + m_config.killDepth,
+                                   PV_NODE);
+        if (val != Timer::TIME_OUT) m_bestDepth = iterativeDepth;
+        STATS(recordIteration(m_cntNodes, m_timer.getTimePass(), val != Timer::TIME_OUT);)
     }
-    return m_timer.getTimePass();
-}
-
-void Core::makeMove(int x, int y, Board::PIECE_COLOR player) {
-    m_pBoard->placeAt(x, y, player);
-    m_moveGenerator.eraseMove({x, y});
-    updateMoveAround(x, y, Board::PIECE_COLOR::BLACK);
-    updateMoveAround(x, y, Board::PIECE_COLOR::WHITE);
-}
-
-void Core::cancelMove(int x, int y) {
-    m_pBoard->unplaceAt(x, y);
-    m_moveGenerator.addMove({x, y});
-    updateMoveAt(x, y, Board::PIECE_COLOR::BLACK);
-    updateMoveAt(x, y, Board::PIECE_COLOR::WHITE);
-    updateMoveAround(x, y, Board::PIECE_COLOR::BLACK);
-    updateMoveAround(x, y, Board::PIECE_COLOR::WHITE);
-}
 
-void Core::updateMoveAt(int x, int y, int dir, Board::PIECE_COLOR player) {
-    int tx = x, ty = y, cnt2 = 0;
-    Board::BOARD_STATE state;
-
-    int lineState = 0, base = 1;
-    for (int step = 1; step <= 4; step++) {
-        tx -= Board::dr[dir];
-        ty -= Board::dc[dir];
-        state = m_pBoard->getState(tx, ty);
-
-        if (state == Board::BOARD_STATE::INVALID || state == (player ^ 1)) {
-            break;
-        }
-
-        lineState = lineState + (state == Board::UNPLACE ? 2 : 1) * base;
-        base *= 3;
-
-        if (state == Board::BOARD_STATE::UNPLACE) {
-            cnt2++;
-        } else {
-            cnt2 = 0;
-        }
-        if (cnt2 == 2) {
+    if (m_bestMove.x == -1) {
+        // timed out before any root move was searched
+        int cntMoves = m_config.branchFactor;
+        for (const Move &move : m_moveGenerator.generateMovesList(cntMoves)) {
+            if (m_color == BoardBase::BLACK && m_moveGenerator.isForbidden(move)) continue;
+            m_bestMove = move;
             break;
         }
     }
 
-    lineState = lineState * 3 + 1;
-
-    tx = x, ty = y, cnt2 = 0;
-    for (int step = 1; step <= 4; step++) {
-        tx += Board::dr[dir];
-        ty += Board::dc[dir];
-        state = m_pBoard->getState(tx, ty);
-
-        if (state == Board::BOARD_STATE::INVALID || state == (player ^ 1)) {
-            break;
-        }
-
-        lineState = lineState * 3 + (state == Board::UNPLACE ? 2 : 1);
+    STATS(m_stats.nodes = m_cntNodes; m_stats.tt = m_TT.stats();
+          std::cerr << m_stats.toLogLine() << std::endl;)
+    return m_timer.getTimePass();
+}
 
-        if (state == Board::BOARD_STATE::UNPLACE) {
-            cnt2++;
-        } else {
-            cnt2 = 0;
-        }
-        if (cnt2 == 2) {
-            break;
-        }
+template <int N>
+void BasicCore<N>::recordIteration(long long nodes, int time, bool complete) {
+    SearchStats::Iteration iteration;
+    iteration.depth = iterativeDepth;
+    iteration.nodes = nodes;
+    iteration.time = time;
+    iteration.complete = complete;
+
+    // nodes grow by the branching factor per ply, compared with the previous iteration
+    // if there is one
+    int plies = iterativeDepth;
+    long long prevNodes = 1;
+    if (!m_stats.iterations.empty()) {
+        plies -= m_stats.iterations.back().depth;
+        prevNodes = m_stats.iterations.back().nodes;
+    }
+    if (plies > 0 && prevNodes > 0 && nodes > 0) {
+        iteration.branching = std::pow((double)nodes / prevNodes, 1.0 / plies);
     }
+    m_stats.iterations.push_back(iteration);
+}
 
-    m_moveGenerator.updateMoveScoreByDir({x, y}, dir,
-                                         m_scorer.getTypeByLineState(lineState), player);
+template <int N>
+void BasicCore<N>::startPondering(const Move &move) {
+    m_predictedMove = move;
+    makeMove(move.x, move.y, static_cast<BoardBase::PIECE_COLOR>(m_color ^ 1));
+    m_stop = false;
+    m_infinite = true;
+    m_ponderThread = std::thread([this]() { run(); });
 }
 
-void Core::updateMoveAt(int x, int y, Board::PIECE_COLOR player) {
-    for (int dir = 0; dir < 4; dir++) {
-        int tx = x, ty = y, cnt2 = 0;
-        Board::BOARD_STATE state;
+template <int N>
+int BasicCore<N>::ponderHit() {
+    m_timer.recordCurrent();
+    m_infinite = false;
+    m_ponderThread.join();
+    return m_timer.getTimePass();
+}
 
-        int lineState = 0, base = 1;
-        for (int step = 1; step <= 4; step++) {
-            tx -= Board::dr[dir];
-            ty -= Board::dc[dir];
-            state = m_pBoard->getState(tx, ty);
+template <int N>
+void BasicCore<N>::stopPondering() {
+    m_stop = true;
+    m_ponderThread.join();
+    m_stop = false;
+    m_infinite = false;
 
-            if (state == Board::BOARD_STATE::INVALID || state == (player ^ 1)) {
-                break;
-            }
+    cancelMove(m_predictedMove.x, m_predictedMove.y);
+}
 
-            lineState = lineState + (state == Board::UNPLACE ? 2 : 1) * base;
-            base *= 3;
+template <int N>
+void BasicCore<N>::makeMove(int x, int y, BoardBase::PIECE_COLOR player) {
+    if (m_pNetwork) m_pNetwork->place(m_accumulator, x, y, player);
+    m_pBoard->placeAt(x, y, player);
+    m_moveGenerator.eraseMove({x, y});
+    updateWindowsAround(x, y, player, true);
+    updateMovesAround(x, y);
+}
 
-            if (state == Board::BOARD_STATE::UNPLACE) {
-                cnt2++;
-            } else {
-                cnt2 = 0;
-            }
-            if (cnt2 == 2) {
-                break;
-            }
-        }
+template <int N>
+void BasicCore<N>::cancelMove(int x, int y) {
+    BoardBase::PIECE_COLOR player =
+        static_cast<BoardBase::PIECE_COLOR>(m_pBoard->getState(x, y));
+    if (m_pNetwork) m_pNetwork->unplace(m_accumulator, x, y, player);
+    m_pBoard->unplaceAt(x, y);
+    // a far move leaves no neighbours behind, and only cells near pieces are candidates
+    if (m_pBoard->cntNeighbour(x, y) > 0) {
+        m_moveGenerator.addMove({x, y});
+        updateMoveAt(x, y, BoardBase::PIECE_COLOR::BLACK);
+        updateMoveAt(x, y, BoardBase::PIECE_COLOR::WHITE);
+    }
+    updateWindowsAround(x, y, player, false);
+    updateMovesAround(x, y);
+}
 
-        lineState = lineState * 3 + 1;
+template <int N>
+void BasicCore<N>::updateMoveAt(int x, int y, int dir, BoardBase::PIECE_COLOR player) {
+    m_moveGenerator.updateMoveScoreByDir(
+        {x, y}, dir,
+        static_cast<Scorer::Type>(m_windowTypes[player][m_windows[player][dir][x][y]]),
+        player);
+}
 
-        tx = x, ty = y, cnt2 = 0;
-        for (int step = 1; step <= 4; step++) {
-            tx += Board::dr[dir];
-            ty += Board::dc[dir];
-            state = m_pBoard->getState(tx, ty);
+template <int N>
+void BasicCore<N>::updateMoveAt(int x, int y, BoardBase::PIECE_COLOR player) {
+    for (int dir = 0; dir < 4; dir++) updateMoveAt(x, y, dir, player);
+}
 
-            if (state == Board::BOARD_STATE::INVALID || state == (player ^ 1)) {
-                break;
-            }
+template <int N>
+int BasicCore<N>::sideWindow(int x, int y, int dx, int dy,
+                             BoardBase::PIECE_COLOR player) const {
+    int window = 0;
+    for (int step = 0; step < Scorer::WINDOW_SIDE; step++) {
+        x += dx;
+        y += dy;
+        int state = m_pBoard->getState(x, y);
+
+        // blocked cells are 0, and so are all cells beyond them
+        if (state == BoardBase::BOARD_STATE::INVALID || state == (player ^ 1)) break;
+        window |= (state == BoardBase::UNPLACE ? 2 : 1) << 2 * step;
+    }
+    return window;
+}
 
-            lineState = lineState * 3 + (state == Board::UNPLACE ? 2 : 1);
+template <int N>
+void BasicCore<N>::updateWindowsAround(int x, int y, BoardBase::PIECE_COLOR color,
+                                       bool placed) {
+    const int sideBits = 2 * Scorer::WINDOW_SIDE;
+    for (int c = 0; c < 2; c++) {
+        BoardBase::PIECE_COLOR player = static_cast<BoardBase::PIECE_COLOR>(c);
+        bool own = player == color;
+        for (int dir = 0; dir < 4; dir++) {
+            for (int side = -1; side <= 1; side += 2) {
+                // cells after (x, y) see it on their low side, cells before on the high
+                int half = side > 0 ? 0 : sideBits;
+                int tx = x, ty = y;
+                for (int step = 1; step <= Scorer::WINDOW_SIDE; step++) {
+                    tx += side * BoardBase::dr[dir];
+                    ty += side * BoardBase::dc[dir];
+                    if (m_pBoard->getState(tx, ty) == BoardBase::INVALID) break;
+
+                    int &window = m_windows[player][dir][tx][ty];
+                    int shift = half + 2 * (step - 1);
+                    if (placed || own) {
+                        // (x, y) is out of sight behind a block, and so are the cells
+                        // further away
+                        if ((window >> shift & 3) == 0) break;
+                        if (own) {
+                            window ^= 3 << shift;
+                        } else {
+                            int cntBits = sideBits - 2 * (step - 1);
+                            window &= ~(((1 << cntBits) - 1) << shift);
+                        }
+                    } else {
+                        // a removed block shows the cells behind it if nothing nearer
+                        // blocks the line
+                        int nearMask = ((1 << 2 * (step - 1)) - 1) << half;
+                        int near = window & nearMask;
+                        if (((near | near >> 1) & 0x55555 & nearMask) !=
+                            (0x55555 & nearMask)) {
+                            break;
+                        }
+                        window = (window & ~(((1 << sideBits) - 1) << half)) |
+                                 sideWindow(tx, ty, -side * BoardBase::dr[dir],
+                                            -side * BoardBase::dc[dir], player)
+                                     << half;
+                    }
 
-            if (state == Board::BOARD_STATE::UNPLACE) {
-                cnt2++;
-            } else {
-                cnt2 = 0;
-            }
-            if (cnt2 == 2) {
-                break;
+                    if (m_moveGenerator.existsMove({tx, ty})) {
+                        updateMoveAt(tx, ty, dir, player);
+                    }
+                }
             }
         }
-
-        m_moveGenerator.updateMoveScoreByDir(
-            {x, y}, dir, m_scorer.getTypeByLineState(lineState), player);
     }
 }
 
-void Core::updateMoveAround(int x, int y, Board::PIECE_COLOR player) {
-    // TODO: use sliding window and only update score in current direction
+template <int N>
+void BasicCore<N>::updateMovesAround(int x, int y) {
     for (int dir = 0; dir < 4; dir++) {
-        int tx = x, ty = y;
-        for (int i = 1; i <= 4; i++) {
-            tx += Board::dr[dir];
-            ty += Board::dc[dir];
-
-            int state = m_pBoard->getState(tx, ty);
-
-            if (state == Board::BOARD_STATE::INVALID || state == (player ^ 1)) {
-                break;
-            }
-
-            if (state == player) {
-                continue;
-            }
-
-            if (m_pBoard->cntNeighbour(tx, ty) == 0) {
-                if (m_moveGenerator.existsMove({tx, ty})) {
-                    m_moveGenerator.eraseMove({tx, ty});
-                }
-                if (i >= 2) break;
-            } else {
-                if (!m_moveGenerator.existsMove({tx, ty})) {
+        for (int side = -1; side <= 1; side += 2) {
+            int tx = x, ty = y;
+            // only the cells within 2 of (x, y) have a different count of neighbours
+            for (int step = 1; step <= 2; step++) {
+                tx += side * BoardBase::dr[dir];
+                ty += side * BoardBase::dc[dir];
+
+                int state = m_pBoard->getState(tx, ty);
+                if (state == BoardBase::BOARD_STATE::INVALID) break;
+                if (state != BoardBase::UNPLACE) continue;
+
+                if (m_pBoard->cntNeighbour(tx, ty) == 0) {
+                    if (m_moveGenerator.existsMove({tx, ty})) {
+                        m_moveGenerator.eraseMove({tx, ty});
+                    }
+                } else if (!m_moveGenerator.existsMove({tx, ty})) {
                     m_moveGenerator.addMove({tx, ty});
+                    updateMoveAt(tx, ty, BoardBase::PIECE_COLOR::BLACK);
+                    updateMoveAt(tx, ty, BoardBase::PIECE_COLOR::WHITE);
                 }
-                updateMoveAt(tx, ty, dir, player);
             }
         }
+    }
+}
 
-        tx = x, ty = y;
-        for (int i = 1; i <= 4; i++) {
-            tx -= Board::dr[dir];
-            ty -= Board::dc[dir];
+template <int N>
+void BasicCore<N>::initWindowTypes() {
+    for (int c = 0; c < 2; c++) {
+        BoardBase::PIECE_COLOR player = static_cast<BoardBase::PIECE_COLOR>(c);
+        m_windowTypes[c] = Scorer::windowTypes(Rule::exactFive(m_config.rule, player));
+    }
+}
 
-            int state = m_pBoard->getState(tx, ty);
+template <int N>
+void BasicCore<N>::initNetwork() {
+    const Network *pNetwork = m_config.network;
+    m_pNetwork = pNetwork && pNetwork->boardSize() == N ? pNetwork : nullptr;
+    if (m_pNetwork) m_pNetwork->refresh(m_accumulator, *m_pBoard);
+}
 
-            if (state == Board::BOARD_STATE::INVALID || state == (player ^ 1)) {
-                break;
-            }
+template <int N>
+TT::Signature BasicCore<N>::ttSignature() const {
+    // FNV-1a over the scores the values are made of
+    uint64_t sum = 14695981039346656037ULL;
+    for (int i = 0; i < Scorer::CNT_TYPES; i++) {
+        sum = (sum ^ (uint64_t)Scorer::TYPE_SCORES[i]) * 1099511628211ULL;
+    }
+    sum = (sum ^ (uint64_t)GOMOKU_BASE_WEIGHT) * 1099511628211ULL;
+    sum = (sum ^ (uint64_t)m_config.killDepth) * 1099511628211ULL;
+
+    const Network *pNetwork = m_config.network;
+    TT::Signature signature = {};
+    signature.rule = m_config.rule;
+    signature.blackWeight = m_config.blackWeight;
+    signature.weightCheck = sum;
+    signature.networkCheck =
+        pNetwork && pNetwork->boardSize() == N ? pNetwork->checksum() : 0;
+    return signature;
+}
 
-            if (state == player) {
-                continue;
-            }
+template <int N>
+int BasicCore<N>::evaluate() const {
+    if (m_pNetwork) return m_pNetwork->evaluate(m_accumulator);
+    return m_moveGenerator.sumPlayerScore(BoardBase::BLACK) * m_config.blackWeight -
+           m_moveGenerator.sumPlayerScore(BoardBase::WHITE);
+}
 
-            if (m_pBoard->cntNeighbour(tx, ty) == 0) {
-                if (m_moveGenerator.existsMove({tx, ty})) {
-                    m_moveGenerator.eraseMove({tx, ty});
-                }
-                if (i >= 2) break;
-            } else {
-                if (!m_moveGenerator.existsMove({tx, ty})) {
-                    m_moveGenerator.addMove({tx, ty});
-                }
-                updateMoveAt(tx, ty, dir, player);
-            }
-        }
+template <int N>
+int BasicCore<N>::evaluateFromScratch() const {
+    if (m_pNetwork) {
+        Network::Accumulator accumulator;
+        m_pNetwork->refresh(accumulator, *m_pBoard);
+        return m_pNetwork->evaluate(accumulator);
     }
+
+    BasicMoveGenerator<N> generator(m_config.rule);
+    initMoves(generator);
+    return generator.sumPlayerScore(BoardBase::BLACK) * m_config.blackWeight -
+           generator.sumPlayerScore(BoardBase::WHITE);
 }
 
-int Core::evaluate() const {
-    return m_moveGenerator.sumPlayerScore(Board::PIECE_COLOR::BLACK) * 5 -
-           m_moveGenerator.sumPlayerScore(Board::PIECE_COLOR::WHITE);
-}
\ No newline at end of file
+#define INSTANTIATE(N) template class BasicCore<N>;
+GOMOKU_FOR_EACH_BOARD_SIZE(INSTANTIATE)
@@ -1,33 +1,131 @@
 #ifndef CORE_H
 #define CORE_H
 
+#include <atomic>
+#include <thread>
+
 #include "board.h"
+#include "book.h"
+#include "config.h"
 #include "generator.h"
 #include "hash.h"
+#include "nnue.h"
+#include "rule.h"
+#include "scanner.h"
 #include "scorer.h"
+#include "stats.h"
 #include "timer.h"
 #include "tt.h"
 
 /**
- * @class Core
- * @brief The Core class represents the core logic of the Gomoku AI.
+ * @class CoreBase
+ * @brief The settings and types shared by the cores of all board sizes.
+ */
+class CoreBase {
+   public:
+    /**
+     * @enum NodeType
+     * @brief Enumerates the expected node types of the principal variation search.
+     */
+    enum NodeType {
+        PV_NODE = 0,  /**< Node searched with an open window */
+        CUT_NODE = 1, /**< Node expected to fail high */
+        ALL_NODE = 2  /**< Node expected to fail low */
+    };
+
+    /**
+     * @brief The maximum score value.
+     */
+    const static int INF = __INT32_MAX__ - 100;
+
+    /**
+     * @brief Gets the settings of the core.
+     *
+     * @return The settings.
+     */
+    const EngineConfig &config() const { return m_config; }
+
+   protected:
+    /**
+     * @brief Constructs the shared part of a core.
+     *
+     * @param config The settings of the core.
+     */
+    explicit CoreBase(const EngineConfig &config) : m_config(config) {}
+
+    /**
+     * @brief Gets the branch factor for a node.
+     *
+     * @param depth The remaining search depth.
+     * @param nodeType The expected type of the node.
+     * @return The number of moves to search.
+     */
+    int branchFactor(int depth, NodeType nodeType) const;
+
+    EngineConfig m_config;  ///< The settings of the core.
+};
+
+/**
+ * @class BasicCore
+ * @brief The BasicCore class represents the core logic of the Gomoku AI.
+ *
+ * The core uses various algorithms and strategies to determine the best move to make.
  *
- * The Core uses various algorithms and strategies to determine the best move to make.
+ * @tparam N The size of the board.
  */
-class Core {
+template <int N>
+class BasicCore : public CoreBase {
    public:
+    using Move = MoveGeneratorBase::Move; /**< A move on the board. */
+
     /**
-     * @brief Constructs a Core object with the specified board.
+     * @brief Constructs a BasicCore object with the specified board.
      *
      * @param pBoard A pointer to the Board object.
      * @param color The color of the core.
+     * @param config The settings of the core, copied.
      */
-    Core(Board *pBoard, Board::PIECE_COLOR);
+    BasicCore(BasicBoard<N> *pBoard, BoardBase::PIECE_COLOR,
+              const EngineConfig &config = EngineConfig());
 
     /**
-     * @brief Destroys the Core object.
+     * @brief Destroys the BasicCore object.
+     *
+     * @note A running ponder search is stopped, but its predicted move is left on the
+     * board.
      */
-    ~Core() {}
+    ~BasicCore();
+
+    /**
+     * @brief Sets up the Core for a new position, keeping the transposition table.
+     *
+     * @param pBoard A pointer to the Board object.
+     * @param color The color of the core.
+     */
+    void setBoard(BasicBoard<N> *pBoard, BoardBase::PIECE_COLOR color);
+
+    /**
+     * @brief Sets the time limit of the search.
+     *
+     * @param timeLimit The time limit in milliseconds.
+     */
+    void setTimeLimit(int timeLimit) { m_config.timeLimit = timeLimit; }
+
+    /**
+     * @brief Sets the deepest iteration of the search.
+     *
+     * @param depth The maximum search depth.
+     */
+    void setDepthLimit(int depth) { m_config.maxSearchDepth = depth; }
+
+    /**
+     * @brief Tells a search to stop, or clears the request.
+     *
+     * @note Safe to call from another thread while run() is in progress; the search
+     * then returns the best move of its last completed iteration.
+     * @param stop Whether the search must stop.
+     */
+    void setStopped(bool stop) { m_stop = stop; }
 
     /**
      * @brief Init timer.
@@ -39,7 +137,7 @@ class Core {
      *
      * @return The best move found by the Core.
      */
-    MoveGenerator::Move bestMove() const { return m_bestMove; }
+    Move bestMove() const { return m_bestMove; }
 
     /**
      * @brief Gets the best score found by the Core.
@@ -48,6 +146,96 @@ class Core {
      */
     int bestScore() const { return m_bestScore; }
 
+    /**
+     * @brief Gets the depth of the last completed search iteration.
+     *
+     * @return The search depth, 0 if no iteration completed.
+     */
+    int bestDepth() const { return m_bestDepth; }
+
+    /**
+     * @brief Gets the number of nodes visited by the last search.
+     *
+     * @return The number of nodes.
+     */
+    long long cntNodes() const { return m_cntNodes; }
+
+    /**
+     * @brief Gets the move generator, whose scores are updated incrementally by
+     * makeMove() and cancelMove().
+     *
+     * @return The move generator.
+     */
+    const BasicMoveGenerator<N> &moveGenerator() const { return m_moveGenerator; }
+
+    /**
+     * @brief Evaluates the current board state from black's point of view, with the
+     * network if one is used and from the incrementally updated scores otherwise.
+     *
+     * @return The evaluation score.
+     */
+    int evaluate() const;
+
+    /**
+     * @brief Evaluates the board from scratch, from a full-board scan or a fresh
+     * accumulator instead of the incrementally updated state, for checking it.
+     *
+     * @return The evaluation score, equal to the incremental one when they agree.
+     */
+    int evaluateFromScratch() const;
+
+    /**
+     * @brief Gets the statistics of the last search.
+     *
+     * @note Only collected when compiled with GOMOKU_STATS.
+     * @return The search statistics.
+     */
+    const SearchStats &stats() const { return m_stats; }
+
+    /**
+     * @brief Gets the color of the core.
+     *
+     * @return The color of the core.
+     */
+    BoardBase::PIECE_COLOR color() const { return m_color; }
+
+    /**
+     * @brief Gets the opponent's expected reply to the best move.
+     *
+     * @return The predicted reply, or {-1, -1} if the search did not predict one.
+     */
+    Move ponderMove() const { return m_ponderMove; }
+
+    /**
+     * @brief Starts searching the position after the predicted opponent reply in a
+     * background thread, without time limit.
+     *
+     * @note The predicted move is made on the board. The board must not be touched until
+     * ponderHit() or stopPondering() is called.
+     * @param move The predicted opponent move.
+     */
+    void startPondering(const Move &move);
+
+    /**
+     * @brief Tells the ponder search that the opponent played the predicted move, and
+     * waits for it to finish within the time limit counted from now.
+     *
+     * @return Core run time since the ponder hit.
+     */
+    int ponderHit();
+
+    /**
+     * @brief Stops the ponder search and takes back the predicted move.
+     */
+    void stopPondering();
+
+    /**
+     * @brief Checks whether a ponder search is in progress.
+     *
+     * @return True if pondering, false otherwise.
+     */
+    bool isPondering() const { return m_ponderThread.joinable(); }
+
     /**
      * @brief Runs the minmax search logic.
      *
@@ -55,6 +243,18 @@ class Core {
      */
     int run();
 
+    /**
+     * @brief Saves the deep entries of the TT to the configured TT file, so that the
+     * next process can start from them.
+     *
+     * @return True if saved, false if there is no TT file or it cannot be written.
+     */
+    bool saveTT() const {
+        return !m_config.ttFile.empty() &&
+               m_TT.save<N>(m_config.ttFile.c_str(), m_config.ttFileDepth,
+                            ttSignature());
+    }
+
     /**
      * @brief Makes a move on the board.
      *
@@ -64,7 +264,7 @@ class Core {
      * @param y The y-coordinate of the move.
      * @param color The color of the piece to be placed.
      */
-    void makeMove(int x, int y, Board::PIECE_COLOR);
+    void makeMove(int x, int y, BoardBase::PIECE_COLOR);
 
     /**
      * @brief Cancels a move on the board.
@@ -76,52 +276,49 @@ class Core {
      */
     void cancelMove(int x, int y);
 
+   private:
     /**
-     * @brief The minimum search depth for the negamax algorithm.
-     */
-    static int MIN_SEARCH_DEPTH;
-
-    /**
-     * @brief The maximum search depth for the negamax algorithm.
-     */
-    static int MAX_SEARCH_DEPTH;
-
-    /**
-     * @brief The depth for killer heuristic (not implemented yet).
+     * @brief Performs the negamax search algorithm to find the best move.
+     *
+     * @param depth The current search depth.
+     * @param player The color of the current player.
+     * @param alpha The alpha value for alpha-beta pruning.
+     * @param beta The beta value for alpha-beta pruning.
+     * @param nodeType The expected type of the node.
+     * @return The score of the best move.
      */
-    static int KILL_DEPTH;
+    int negMiniMaxSearch(int depth, BoardBase::PIECE_COLOR player, int alpha, int beta,
+                         NodeType nodeType);
 
     /**
-     * @brief Flag indicating whether to use iterative deepening in the search algorithm.
+     * @brief The windows of every cell by player, direction and position, see
+     * Scorer::getTypeByWindow. Occupied cells keep the windows they had when empty.
      */
-    static bool ITERATIVE_DEEPENING;
+    typedef int Windows[2][4][N][N];
 
     /**
-     * @brief The branch factor used in move generation.
+     * @brief Adds the moves around the placed pieces of the board to a move generator
+     * and scores them from a full-board scan.
+     * @param generator The empty move generator.
+     * @param pWindows Receives the windows of the scan if not null.
      */
-    static int BRANCH_FACTOR;
+    void initMoves(BasicMoveGenerator<N> &generator, Windows *pWindows = nullptr) const;
 
     /**
-     * @brief The maximum score value.
+     * @brief Picks the window type tables of both players for the rule.
      */
-    const static int INF = __INT32_MAX__ - 100;
+    void initWindowTypes();
 
     /**
-     * @brief The time limit for the search algorithm.
+     * @brief Picks up the network if it fits the board size and computes the
+     * accumulator of the board.
      */
-    const static int TIME_LIMIT = 5900;
+    void initNetwork();
 
-   private:
     /**
-     * @brief Performs the negamax search algorithm to find the best move.
-     *
-     * @param depth The current search depth.
-     * @param player The color of the current player.
-     * @param alpha The alpha value for alpha-beta pruning.
-     * @param beta The beta value for alpha-beta pruning.
-     * @return The score of the best move.
+     * @brief Gets the settings the TT values depend on, which a TT file must match.
      */
-    int negMiniMaxSearch(int depth, Board::PIECE_COLOR player, int alpha, int beta);
+    TT::Signature ttSignature() const;
 
     /**
      * @brief Updates the move at the specified position on the board.
@@ -130,7 +327,7 @@ class Core {
      * @param y The y-coordinate of the move.
      * @param color The color of the piece.
      */
-    void updateMoveAt(int x, int y, Board::PIECE_COLOR);
+    void updateMoveAt(int x, int y, BoardBase::PIECE_COLOR);
 
     /**
      * @brief Updates the move at the specified position on the board in the specified
@@ -141,37 +338,85 @@ class Core {
      * @param dir The direction of the move.
      * @param color The color of the piece.
      */
-    void updateMoveAt(int x, int y, int dir, Board::PIECE_COLOR);
+    void updateMoveAt(int x, int y, int dir, BoardBase::PIECE_COLOR);
 
     /**
-     * @brief Updates the moves around the specified position on the board.
+     * @brief Reads one side of a window from the board.
      *
      * @param x The x-coordinate of the move.
      * @param y The y-coordinate of the move.
+     * @param dx The step along the x-coordinate.
+     * @param dy The step along the y-coordinate.
+     * @param player The color of the player.
+     * @return The side in the low bits of a window.
+     */
+    int sideWindow(int x, int y, int dx, int dy, BoardBase::PIECE_COLOR player) const;
+
+    /**
+     * @brief Updates the windows that see a placed or removed piece and the moves
+     * holding them.
+     *
+     * A piece changes one cell of each window in sight, so the update is a few bit
+     * operations per window; only a removed block makes the cells behind it visible
+     * again, which reads them from the board.
+     * @param x The x-coordinate of the piece.
+     * @param y The y-coordinate of the piece.
      * @param color The color of the piece.
+     * @param placed Whether the piece was placed or removed.
      */
-    void updateMoveAround(int x, int y, Board::PIECE_COLOR);
+    void updateWindowsAround(int x, int y, BoardBase::PIECE_COLOR color, bool placed);
 
     /**
-     * @brief Evaluates the current board state.
+     * @brief Adds and erases the moves around the specified position whose count of
+     * neighbours changed.
      *
-     * @return The evaluation score.
+     * @param x The x-coordinate of the move.
+     * @param y The y-coordinate of the move.
      */
-    int evaluate() const;
+    void updateMovesAround(int x, int y);
 
-    Board *m_pBoard = nullptr;  ///< A pointer to the Board object.
+    /**
+     * @brief Appends the statistics of the current iteration to the search statistics.
+     *
+     * @param nodes The nodes visited by the iteration.
+     * @param time The time spent on the iteration.
+     * @param complete Whether the iteration finished in time.
+     */
+    void recordIteration(long long nodes, int time, bool complete);
+
+    BasicBoard<N> *m_pBoard = nullptr;  ///< A pointer to the Board object.
 
-    Timer m_timer;                  ///< The timer object.
-    TT m_TT;                        ///< The transposition table object.
-    MoveGenerator m_moveGenerator;  ///< The move generator object.
-    Scorer m_scorer;                ///< The scorer object.
+    Timer m_timer;                          ///< The timer object.
+    TT m_TT;                                ///< The transposition table object.
+    BasicMoveGenerator<N> m_moveGenerator;  ///< The move generator object.
+    const unsigned char *m_windowTypes[2];  ///< The window types of each player.
+    Windows m_windows;                      ///< The windows of every cell.
 
-    MoveGenerator::Move m_bestMove;    ///< The best move found by the Core.
+    const Network *m_pNetwork = nullptr;  ///< The network evaluating the board, if any.
+    Network::Accumulator m_accumulator;   ///< The first layer of m_pNetwork.
+
+    Move m_bestMove;                   ///< The best move found by the Core.
     int m_bestScore = -__INT32_MAX__;  ///< The best score found by the Core.
+    int m_bestDepth = 0;               ///< The depth of the last completed iteration.
+    long long m_cntNodes = 0;          ///< The number of nodes visited by the search.
+    SearchStats m_stats;               ///< The statistics of the last search.
 
-    Board::PIECE_COLOR m_color = Board::PIECE_COLOR::WHITE;  ///< The color of the core.
+    BoardBase::PIECE_COLOR m_color = BoardBase::WHITE;  ///< The color of the core.
 
     int iterativeDepth = 4;  ///< The current depth of the iterative deepening search.
+
+    Move m_ponderMove;                     ///< The predicted reply to the best move.
+    Move m_replyCandidate;                 ///< The best reply in the current root child.
+    Move m_predictedMove;                  ///< The move the ponder search assumes.
+
+    std::thread m_ponderThread;            ///< The thread running the ponder search.
+    std::atomic<bool> m_stop{false};       ///< Whether the search must stop.
+    std::atomic<bool> m_infinite{false};   ///< Whether the search ignores the time limit.
 };
 
+/**
+ * @brief The core for the standard game board.
+ */
+using Core = BasicCore<BoardBase::DEFAULT_SIZE>;
+
 #endif
\ No newline at end of file
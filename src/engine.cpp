@@ -0,0 +1,115 @@
+#include "engine.h"
+
+Engine::Engine(const EngineConfig &config)
+    : m_config(config), m_core(&m_board, BoardBase::BLACK, config) {}
+
+bool Engine::setPosition(const std::vector<Move> &moves) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t cntCommon = 0;
+    while (cntCommon < m_moves.size() && cntCommon < moves.size() &&
+           m_moves[cntCommon].x == moves[cntCommon].x &&
+           m_moves[cntCommon].y == moves[cntCommon].y) {
+        cntCommon++;
+    }
+
+    std::vector<Move> previous = m_moves;
+    undoTo(cntCommon);
+    for (size_t i = cntCommon; i < moves.size(); i++) {
+        if (playLocked(moves[i])) continue;
+
+        undoTo(cntCommon);
+        for (size_t j = cntCommon; j < previous.size(); j++) playLocked(previous[j]);
+        return false;
+    }
+    return true;
+}
+
+bool Engine::play(const Move &move) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return playLocked(move);
+}
+
+Engine::Result Engine::search(const Limits &limits) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // the core searches for its own color
+    BoardBase::PIECE_COLOR color = sideToMoveLocked();
+    if (m_core.color() != color) m_core.setBoard(&m_board, color);
+    m_core.setTimeLimit(limits.time > 0 ? limits.time : m_config.timeLimit);
+    m_core.setDepthLimit(limits.depth > 0 ? limits.depth : m_config.maxSearchDepth);
+
+    {
+        std::lock_guard<std::mutex> stopLock(m_stopMutex);
+        m_searching = true;
+    }
+    m_core.initTimer();
+    int time = m_core.run();
+    {
+        std::lock_guard<std::mutex> stopLock(m_stopMutex);
+        m_searching = false;
+        m_core.setStopped(false);
+    }
+
+    m_result = Result();
+    m_result.bestMove = m_core.bestMove();
+    m_result.score = m_core.bestScore();
+    m_result.depth = m_core.bestDepth();
+    m_result.nodes = m_core.cntNodes();
+    m_result.time = time;
+    if (m_result.bestMove.x != -1) {
+        m_result.pv.push_back(m_result.bestMove);
+        Move reply = m_core.ponderMove();
+        if (reply.x != -1) m_result.pv.push_back(reply);
+    }
+    return m_result;
+}
+
+void Engine::stop() {
+    std::lock_guard<std::mutex> stopLock(m_stopMutex);
+    if (m_searching) m_core.setStopped(true);
+}
+
+Engine::Result Engine::lastResult() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_result;
+}
+
+std::vector<Engine::Move> Engine::moves() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_moves;
+}
+
+BoardBase::PIECE_COLOR Engine::sideToMove() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return sideToMoveLocked();
+}
+
+bool Engine::isConsistent() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_core.evaluate() == m_core.evaluateFromScratch();
+}
+
+BoardBase::PIECE_COLOR Engine::sideToMoveLocked() const {
+    // black moves first
+    return m_moves.size() % 2 ? BoardBase::WHITE : BoardBase::BLACK;
+}
+
+bool Engine::playLocked(const Move &move) {
+    if (m_board.getState(move.x, move.y) != BoardBase::UNPLACE) return false;
+
+    BoardBase::PIECE_COLOR color = sideToMoveLocked();
+    if (color == BoardBase::BLACK && m_core.moveGenerator().isForbidden(move)) {
+        return false;
+    }
+    m_core.makeMove(move.x, move.y, color);
+    m_moves.push_back(move);
+    return true;
+}
+
+void Engine::undoTo(size_t cntMoves) {
+    while (m_moves.size() > cntMoves) {
+        m_core.cancelMove(m_moves.back().x, m_moves.back().y);
+        m_moves.pop_back();
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <mutex>
+#include <vector>
+
+#include "config.h"
+#include "core.h"
+
+/**
+ * @class Engine
+ * @brief A self-contained engine for embedding, the entry point of libgomoku.
+ *
+ * An Engine owns its board, core and transposition table and reads its settings only
+ * from its EngineConfig, so any number of engines can live in one process. All methods
+ * may be called from any thread: they are serialized by a mutex, except stop(), which
+ * interrupts a search running in another thread. The only process-wide setting is the
+ * Zobrist seed (Zobrist::setSeed), which must be chosen before the first engine is
+ * created.
+ */
+class Engine {
+   public:
+    using Move = MoveGeneratorBase::Move; /**< A move on the board. */
+
+    /**
+     * @struct Limits
+     * @brief The limits of one search.
+     */
+    struct Limits {
+        int time = 0;  /**< The time limit in milliseconds, 0 for the config's. */
+        int depth = 0; /**< The maximum search depth, 0 for the config's. */
+    };
+
+    /**
+     * @struct Result
+     * @brief The outcome of a search.
+     */
+    struct Result {
+        Move bestMove = {-1, -1}; /**< The best move, {-1, -1} if there is none. */
+        int score = 0;            /**< The score of the best move for the side to move. */
+        int depth = 0;            /**< The depth of the last completed iteration. */
+        long long nodes = 0;      /**< The number of nodes visited. */
+        int time = 0;             /**< The time spent in milliseconds. */
+        std::vector<Move> pv;     /**< The best move and the predicted reply, if any. */
+    };
+
+    /**
+     * @brief Constructs an engine on an empty board.
+     * @param config The settings of the engine, copied. The book and network it points
+     * to are shared read-only and must outlive the engine.
+     */
+    explicit Engine(const EngineConfig &config = EngineConfig());
+
+    Engine(const Engine &) = delete;
+    Engine &operator=(const Engine &) = delete;
+
+    /**
+     * @brief Sets up a position from its moves. Only the moves that differ from the
+     * current position are undone and replayed.
+     * @param moves The moves of the game, black first.
+     * @return False if a move is off the board, on an occupied cell or forbidden; the
+     * position is then left unchanged.
+     */
+    bool setPosition(const std::vector<Move> &moves);
+
+    /**
+     * @brief Plays a move for the side to move.
+     * @param move The move.
+     * @return False if the move is off the board, on an occupied cell or forbidden.
+     */
+    bool play(const Move &move);
+
+    /**
+     * @brief Searches the best move for the side to move.
+     * @param limits The limits of the search.
+     * @return The result, also kept for lastResult().
+     */
+    Result search(const Limits &limits);
+
+    /**
+     * @brief Searches the best move for the side to move within the config's limits.
+     * @return The result, also kept for lastResult().
+     */
+    Result search() { return search(Limits()); }
+
+    /**
+     * @brief Stops a search in progress, which then returns the result of its last
+     * completed iteration. Does nothing if no search is running.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the result of the last search.
+     * @return The result.
+     */
+    Result lastResult() const;
+
+    /**
+     * @brief Gets the moves of the current position.
+     * @return The moves, black first.
+     */
+    std::vector<Move> moves() const;
+
+    /**
+     * @brief Gets the side to move.
+     * @return The color of the side to move.
+     */
+    BoardBase::PIECE_COLOR sideToMove() const;
+
+    /**
+     * @brief Checks that the incrementally updated evaluation of the current position
+     * matches one computed from scratch, for the checks of gomoku_perft.
+     * @return True if both evaluations agree.
+     */
+    bool isConsistent() const;
+
+   private:
+    /**
+     * @brief Gets the side to move with m_mutex held.
+     */
+    BoardBase::PIECE_COLOR sideToMoveLocked() const;
+
+    /**
+     * @brief Plays a move with m_mutex held.
+     */
+    bool playLocked(const Move &move);
+
+    /**
+     * @brief Takes back moves with m_mutex held until cntMoves are left.
+     */
+    void undoTo(size_t cntMoves);
+
+    EngineConfig m_config;     ///< The settings of the engine.
+    Board m_board;             ///< The board of the current position.
+    Core m_core;               ///< The core searching m_board.
+    std::vector<Move> m_moves; ///< The moves of the current position.
+    Result m_result;           ///< The result of the last search.
+
+    mutable std::mutex m_mutex; ///< Serializes the public methods except stop().
+    std::mutex m_stopMutex;     ///< Orders stop() against the start and end of a search.
+    bool m_searching = false;   ///< Whether a search is running, under m_stopMutex.
+};
+
+#endif
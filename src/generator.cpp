@@ -6,144 +6,215 @@
 
 #define max(a, b) ((a) >= (b) ? (a) : (b))
 
-MoveGenerator::MoveGenerator() {
-    for (int i = 0; i < Board::BOARD_SIZE; ++i) {
-        for (int j = 0; j < Board::BOARD_SIZE; ++j) {
-            m_maxScore[i][j] = INVALID_MOVE_WEIGHT;
-            m_recorded[i][j] = 0;
-        }
+template <int N>
+BasicMoveGenerator<N>::BasicMoveGenerator(Rule::TYPE rule) : m_rule(rule) {
+    // every field is set, so that a generator reused through assignment keeps nothing
+    // of the previous position
+    Cell empty = {};
+    for (int i = 0; i < 4; i++) {
+        empty.dirType[BoardBase::PIECE_COLOR::BLACK][i] =
+            empty.dirType[BoardBase::PIECE_COLOR::WHITE][i] = Scorer::BASE;
+    }
+    empty.maxScore = INVALID_MOVE_WEIGHT;
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) m_cells[i][j] = empty;
     }
 }
 
-void MoveGenerator::sortMoves() {
+template <int N>
+void BasicMoveGenerator<N>::sortMoves() {
     std::sort(m_moves.begin(), m_moves.end(), [&](const Move &a, const Move &b) {
-        return m_maxScore[a.x][a.y] > m_maxScore[b.x][b.y];
+        return m_cells[a.x][a.y].maxScore > m_cells[b.x][b.y].maxScore;
     });
 
     // remove erased moves
     while (m_moves.size() > 0) {
         const Move &last = m_moves.back();
-        if (m_maxScore[last.x][last.y] != INVALID_MOVE_WEIGHT) break;
+        if (m_cells[last.x][last.y].maxScore != INVALID_MOVE_WEIGHT) break;
         m_moves.pop_back();
-        m_recorded[last.x][last.y] = 0;
+        m_cells[last.x][last.y].recorded = false;
     }
 }
 
-void MoveGenerator::updateMoveScoreByDir(const Move &move, int dir, Scorer::Type type,
-                                         Board::PIECE_COLOR player) {
-    if (type == m_dirType[player][dir][move.x][move.y]) return;
+namespace {
+
+/**
+ * @brief Gets the bonus for combined threats of a move.
+ *
+ * The bonus only depends on the counts, so it does not matter in which order the
+ * directions of a move are updated.
+ * @param cntS4 The number of SLEEP_FOUR directions.
+ * @param cntL3 The number of LIVE_THREE directions.
+ * @return The bonus score.
+ */
+int killScore(int cntS4, int cntL3) {
+    int score = 0;
+    if (cntS4 > 1) score += (cntS4 - 1) * Scorer::TYPE_SCORES[Scorer::KILL_1];
+    if (cntL3 > 1) score += (cntL3 - 1) * Scorer::TYPE_SCORES[Scorer::KILL_2];
+    if (cntS4 && cntL3) score += Scorer::TYPE_SCORES[Scorer::KILL_2];
+    return score;
+}
 
-    Scorer::Type preType = m_dirType[player][dir][move.x][move.y];
-    m_dirType[player][dir][move.x][move.y] = type;
+}  // namespace
 
-    int dw = Scorer::TYPE_SCORES[type] - Scorer::TYPE_SCORES[preType];
+template <int N>
+void BasicMoveGenerator<N>::updateMoveScoreByDir(const Move &move, int dir,
+                                                 Scorer::Type type,
+                                                 BoardBase::PIECE_COLOR player) {
+    Cell &cell = m_cells[move.x][move.y];
+    if (type == cell.dirType[player][dir]) return;
 
-    if (preType == Scorer::SLEEP_FOUR) {
-        m_cntS4[player][move.x][move.y]--;
+    Scorer::Type preType = static_cast<Scorer::Type>(cell.dirType[player][dir]);
+    cell.dirType[player][dir] = type;
 
-        if (m_cntS4[player][move.x][move.y]) {
-            dw -= Scorer::TYPE_SCORES[Scorer::KILL_1];
-        }
+    uint8_t &cntS4 = cell.cntS4[player];
+    uint8_t &cntL3 = cell.cntL3[player];
+    int dw = Scorer::TYPE_SCORES[type] - Scorer::TYPE_SCORES[preType] -
+             killScore(cntS4, cntL3);
 
-        if (m_cntL3[player][move.x][move.y]) {
-            dw -= Scorer::TYPE_SCORES[Scorer::KILL_2];
-        }
+    if (preType == Scorer::SLEEP_FOUR) {
+        cntS4--;
     } else if (preType == Scorer::LIVE_THREE) {
-        m_cntL3[player][move.x][move.y]--;
-
-        if (m_cntS4[player][move.x][move.y]) {
-            dw -= Scorer::TYPE_SCORES[Scorer::KILL_2];
-        }
-
-        if (m_cntL3[player][move.x][move.y]) {
-            dw -= Scorer::TYPE_SCORES[Scorer::KILL_2];
-        }
+        cntL3--;
     }
 
     if (type == Scorer::SLEEP_FOUR) {
-        if (m_cntS4[player][move.x][move.y]) {
-            dw += Scorer::TYPE_SCORES[Scorer::KILL_1];
-        }
-
-        if (m_cntL3[player][move.x][move.y]) {
-            dw += Scorer::TYPE_SCORES[Scorer::KILL_2];
-        }
-
-        m_cntS4[player][move.x][move.y]++;
+        cntS4++;
     } else if (type == Scorer::LIVE_THREE) {
-        if (m_cntS4[player][move.x][move.y]) {
-            dw += Scorer::TYPE_SCORES[Scorer::KILL_2];
-        }
-
-        if (m_cntL3[player][move.x][move.y]) {
-            dw += Scorer::TYPE_SCORES[Scorer::KILL_2];
-        }
+        cntL3++;
+    }
+    dw += killScore(cntS4, cntL3);
 
-        m_cntL3[player][move.x][move.y]++;
+    if (!Rule::hasForbidden(m_rule, player)) {
+        cell.playerScore[player] += dw;
+        m_sumPlayerScore[player] += dw;
+        cell.maxScore += dw;
+        return;
     }
 
-    m_playerMoveScore[player][move.x][move.y] += dw;
-    m_sumPlayerScore[player] += dw;
+    // forbidden moves leave the sums, so only the change of the counted score applies
+    int preScore = effectiveScore(move, player);
+    cell.playerScore[player] += dw;
+    cell.forbidden = checkForbidden(move);
+    int change = effectiveScore(move, player) - preScore;
+    m_sumPlayerScore[player] += change;
+    cell.maxScore += change;
+}
 
-    m_maxScore[move.x][move.y] += dw;
+template <int N>
+bool BasicMoveGenerator<N>::checkForbidden(const Move &move) const {
+    int cntFours = 0, cntThrees = 0;
+    bool overline = false;
+    for (int dir = 0; dir < 4; dir++) {
+        switch (dirType(move, dir, BoardBase::BLACK)) {
+            case Scorer::FIVE:
+                // a five wins even if it also makes a forbidden shape
+                return false;
+            case Scorer::OVERLINE:
+                overline = true;
+                break;
+            case Scorer::DOUBLE_FOUR:
+                cntFours += 2;
+                break;
+            case Scorer::LIVE_FOUR:
+            case Scorer::SLEEP_FOUR:
+                cntFours++;
+                break;
+            case Scorer::LIVE_THREE:
+                cntThrees++;
+                break;
+            default:
+                break;
+        }
+    }
+    return overline || cntFours > 1 || cntThrees > 1;
 }
 
-void MoveGenerator::addMove(const Move &move) {
-    if (!m_recorded[move.x][move.y]) {
+template <int N>
+void BasicMoveGenerator<N>::addMove(const Move &move) {
+    Cell &cell = m_cells[move.x][move.y];
+    if (!cell.recorded) {
         m_moves.push_back(move);
-        m_recorded[move.x][move.y] = 1;
+        cell.recorded = true;
     }
 
-    int baseScore = Scorer::BASE_SCORES[move.x][move.y];
+    int baseScore = Scorer::baseScore(move.x, move.y, N);
 
     for (int i = 0; i < 4; i++) {
-        m_dirType[Board::PIECE_COLOR::BLACK][i][move.x][move.y] =
-            m_dirType[Board::PIECE_COLOR::WHITE][i][move.x][move.y] = Scorer::BASE;
+        cell.dirType[BoardBase::PIECE_COLOR::BLACK][i] =
+            cell.dirType[BoardBase::PIECE_COLOR::WHITE][i] = Scorer::BASE;
     }
 
-    m_playerMoveScore[Board::PIECE_COLOR::BLACK][move.x][move.y] =
-        m_playerMoveScore[Board::PIECE_COLOR::WHITE][move.x][move.y] = baseScore;
+    cell.playerScore[BoardBase::PIECE_COLOR::BLACK] =
+        cell.playerScore[BoardBase::PIECE_COLOR::WHITE] = baseScore;
+
+    cell.maxScore = baseScore;
 
-    m_maxScore[move.x][move.y] = baseScore;
+    cell.cntL3[BoardBase::PIECE_COLOR::BLACK] =
+        cell.cntL3[BoardBase::PIECE_COLOR::WHITE] = 0;
 
-    m_cntL3[Board::PIECE_COLOR::BLACK][move.x][move.y] =
-        m_cntL3[Board::PIECE_COLOR::WHITE][move.x][move.y] = 0;
+    cell.cntS4[BoardBase::PIECE_COLOR::BLACK] =
+        cell.cntS4[BoardBase::PIECE_COLOR::WHITE] = 0;
 
-    m_cntS4[Board::PIECE_COLOR::BLACK][move.x][move.y] =
-        m_cntS4[Board::PIECE_COLOR::WHITE][move.x][move.y] = 0;
+    cell.forbidden = false;
 
-    m_sumPlayerScore[Board::PIECE_COLOR::BLACK] += baseScore;
-    m_sumPlayerScore[Board::PIECE_COLOR::WHITE] += baseScore;
+    m_sumPlayerScore[BoardBase::PIECE_COLOR::BLACK] += baseScore;
+    m_sumPlayerScore[BoardBase::PIECE_COLOR::WHITE] += baseScore;
 }
 
-void MoveGenerator::eraseMove(const Move &move) {
-    m_sumPlayerScore[Board::PIECE_COLOR::BLACK] -=
-        m_playerMoveScore[Board::PIECE_COLOR::BLACK][move.x][move.y];
-    m_sumPlayerScore[Board::PIECE_COLOR::WHITE] -=
-        m_playerMoveScore[Board::PIECE_COLOR::WHITE][move.x][move.y];
+template <int N>
+void BasicMoveGenerator<N>::eraseMove(const Move &move) {
+    // a move outside the list, such as a far move of the opponent, adds nothing to the
+    // sums
+    if (!existsMove(move)) return;
 
-    m_maxScore[move.x][move.y] = INVALID_MOVE_WEIGHT;
+    m_sumPlayerScore[BoardBase::PIECE_COLOR::BLACK] -=
+        effectiveScore(move, BoardBase::PIECE_COLOR::BLACK);
+    m_sumPlayerScore[BoardBase::PIECE_COLOR::WHITE] -=
+        effectiveScore(move, BoardBase::PIECE_COLOR::WHITE);
+
+    m_cells[move.x][move.y].maxScore = INVALID_MOVE_WEIGHT;
 }
 
-std::vector<MoveGenerator::Move> MoveGenerator::generateMovesList(int cnt) {
+template <int N>
+std::vector<MoveGeneratorBase::Move> BasicMoveGenerator<N>::generateMovesList(
+    int cnt, int scoreCutRatio) {
     sortMoves();
+    if (scoreCutRatio > 0 && !m_moves.empty()) {
+        long long bestScore = m_cells[m_moves[0].x][m_moves[0].y].maxScore;
+        int i = 1;
+        while (i < cnt && i < (int)m_moves.size() &&
+               (long long)m_cells[m_moves[i].x][m_moves[i].y].maxScore * scoreCutRatio >=
+                   bestScore) {
+            i++;
+        }
+        cnt = i;
+    }
     return cnt < m_moves.size()
                ? std::vector<Move>(m_moves.begin(), m_moves.begin() + cnt)
                : m_moves;
 }
 
-bool MoveGenerator::existsMove(const Move &move) {
-    return m_maxScore[move.x][move.y] != INVALID_MOVE_WEIGHT;
+template <int N>
+bool BasicMoveGenerator<N>::existsMove(const Move &move) const {
+    return m_cells[move.x][move.y].maxScore != INVALID_MOVE_WEIGHT;
 }
 
-int MoveGenerator::playerMoveScore(const Move &move, Board::PIECE_COLOR color) const {
-    return m_playerMoveScore[color][move.x][move.y];
+template <int N>
+int BasicMoveGenerator<N>::playerMoveScore(const Move &move,
+                                           BoardBase::PIECE_COLOR color) const {
+    return effectiveScore(move, color);
 }
 
-int MoveGenerator::maxMoveScore(const Move &move) const {
-    return m_maxScore[move.x][move.y];
+template <int N>
+int BasicMoveGenerator<N>::maxMoveScore(const Move &move) const {
+    return m_cells[move.x][move.y].maxScore;
 }
 
-int MoveGenerator::sumPlayerScore(Board::PIECE_COLOR color) const {
+template <int N>
+int BasicMoveGenerator<N>::sumPlayerScore(BoardBase::PIECE_COLOR color) const {
     return m_sumPlayerScore[color];
-}
\ No newline at end of file
+}
+
+#define INSTANTIATE(N) template class BasicMoveGenerator<N>;
+GOMOKU_FOR_EACH_BOARD_SIZE(INSTANTIATE)
@@ -1,16 +1,18 @@
 #ifndef GENERATOR_H
 #define GENERATOR_H
 
+#include <cstdint>
 #include <vector>
 
 #include "board.h"
+#include "rule.h"
 #include "scorer.h"
 
 /**
- * @class MoveGenerator
- * @brief Generates and manages moves for the Gomoku game.
+ * @class MoveGeneratorBase
+ * @brief The parts of the move generator that do not depend on the board size.
  */
-class MoveGenerator {
+class MoveGeneratorBase {
    public:
     /**
      * @struct Move
@@ -28,10 +30,24 @@ class MoveGenerator {
         bool operator==(const Move &other) const { return x == other.x && y == other.y; }
     };
 
+    const static int INVALID_MOVE_WEIGHT =
+        -__INT32_MAX__; /**< The weight assigned to an invalid move. */
+};
+
+/**
+ * @class BasicMoveGenerator
+ * @brief Generates and manages moves for the Gomoku game.
+ *
+ * @tparam N The size of the board.
+ */
+template <int N>
+class BasicMoveGenerator : public MoveGeneratorBase {
+   public:
     /**
-     * @brief Default constructor for MoveGenerator.
+     * @brief Constructs a BasicMoveGenerator.
+     * @param rule The rule set, which decides the forbidden moves.
      */
-    MoveGenerator();
+    explicit BasicMoveGenerator(Rule::TYPE rule = Rule::FREESTYLE);
 
     /**
      * @brief Sorts the moves in the move list.
@@ -46,7 +62,7 @@ class MoveGenerator {
      * @param color The piece color.
      */
     void updateMoveScoreByDir(const Move &move, int dir, Scorer::Type,
-                              Board::PIECE_COLOR);
+                              BoardBase::PIECE_COLOR);
 
     /**
      * @brief Adds a move to the move list.
@@ -55,7 +71,7 @@ class MoveGenerator {
     void addMove(const Move &move);
 
     /**
-     * @brief Erases a move from the move list.
+     * @brief Erases a move from the move list. Does nothing if the move is not in it.
      * @param move The move to erase.
      */
     void eraseMove(const Move &move);
@@ -65,14 +81,26 @@ class MoveGenerator {
      * @param move The move to check.
      * @return True if the move exists, false otherwise.
      */
-    bool existsMove(const Move &move);
+    bool existsMove(const Move &move) const;
+
+    /**
+     * @brief Checks if a move is forbidden for black.
+     * @note Only renju has forbidden moves. Forbidden moves score 0 for black.
+     * @param move The move to check.
+     * @return True if the move is in the move list and forbidden, false otherwise.
+     */
+    bool isForbidden(const Move &move) const {
+        return m_cells[move.x][move.y].forbidden && existsMove(move);
+    }
 
     /**
      * @brief Generates a list of moves.
      * @param cnt The number of moves to generate.
+     * @param scoreCutRatio Moves scoring below the best score divided by this ratio are
+     * left out. 0 keeps every move.
      * @return The generated list of moves.
      */
-    std::vector<Move> generateMovesList(int cnt);
+    std::vector<Move> generateMovesList(int cnt, int scoreCutRatio = 0);
 
     /**
      * @brief Calculates the score of a player's move.
@@ -80,7 +108,7 @@ class MoveGenerator {
      * @param color The player's piece color.
      * @return The score of the player's move.
      */
-    int playerMoveScore(const Move &move, Board::PIECE_COLOR color) const;
+    int playerMoveScore(const Move &move, BoardBase::PIECE_COLOR color) const;
 
     /**
      * @brief Calculates the maximum score of a move.
@@ -94,29 +122,69 @@ class MoveGenerator {
      * @param color The player's piece color.
      * @return The sum of the player's scores.
      */
-    int sumPlayerScore(Board::PIECE_COLOR color) const;
+    int sumPlayerScore(BoardBase::PIECE_COLOR color) const;
 
-    const static int INVALID_MOVE_WEIGHT =
-        -__INT32_MAX__; /**< The weight assigned to an invalid move. */
+    /**
+     * @struct Cell
+     * @brief The state of one move, kept together so that updating a move touches a
+     * single cache line.
+     */
+    struct alignas(32) Cell {
+        int32_t playerScore[2]; /**< The score of the move for each player. */
+        int32_t maxScore;       /**< The maximum score of the move. */
+        uint8_t dirType[2][4];  /**< The Scorer::Type of each player and direction. */
+        uint8_t cntS4[2];       /**< The count of S4 patterns for each player. */
+        uint8_t cntL3[2];       /**< The count of L3 patterns for each player. */
+        bool recorded;          /**< Whether the move is in m_moves. */
+        bool forbidden;         /**< Whether the move is forbidden for black. */
+    };
+    static_assert(sizeof(Cell) == 32, "two cells share a cache line, none straddles one");
+
+    /**
+     * @brief Gets the state of a move.
+     * @param move The move.
+     * @return The state of the move.
+     */
+    const Cell &cell(const Move &move) const { return m_cells[move.x][move.y]; }
+
+    /**
+     * @brief Gets the type of a player's line through a move.
+     * @param move The move.
+     * @param dir The direction of the line.
+     * @param color The player's piece color.
+     * @return The type of the line.
+     */
+    Scorer::Type dirType(const Move &move, int dir, BoardBase::PIECE_COLOR color) const {
+        return static_cast<Scorer::Type>(m_cells[move.x][move.y].dirType[color][dir]);
+    }
 
    public:
-    std::vector<Move> m_moves; /**< The list of moves. */
-    int m_recorded[Board::BOARD_SIZE]
-                  [Board::BOARD_SIZE]; /**< The recorded moves on the board. */
-    Scorer::Type m_dirType[2][4][Board::BOARD_SIZE]
-                          [Board::BOARD_SIZE]; /**< The scorer types for each direction on
-                                                  the board. */
-    int m_playerMoveScore[2][Board::BOARD_SIZE]
-                         [Board::BOARD_SIZE]; /**< The scores of the player's moves. */
-    int m_maxScore[Board::BOARD_SIZE]
-                  [Board::BOARD_SIZE]; /**< The maximum scores of moves. */
-    int m_cntS4[2][Board::BOARD_SIZE]
-               [Board::BOARD_SIZE]; /**< The count of S4 patterns for each move of each
-                                       player. */
-    int m_cntL3[2][Board::BOARD_SIZE]
-               [Board::BOARD_SIZE];   /**< The count of L3 patterns for each move of each
-                                         player. */
+    std::vector<Move> m_moves;        /**< The list of moves. */
+    Cell m_cells[N][N];               /**< The state of each move on the board. */
     int m_sumPlayerScore[2] = {0, 0}; /**< The sum of each player's scores. */
+    Rule::TYPE m_rule;                /**< The rule set. */
+
+   private:
+    /**
+     * @brief Checks the types of black's lines through a move for a double three, double
+     * four or overline without a five.
+     */
+    bool checkForbidden(const Move &move) const;
+
+    /**
+     * @brief Gets the score of a move that counts towards the sums, 0 for black's
+     * forbidden moves.
+     */
+    int effectiveScore(const Move &move, BoardBase::PIECE_COLOR color) const {
+        const Cell &cell = m_cells[move.x][move.y];
+        if (color == BoardBase::BLACK && cell.forbidden) return 0;
+        return cell.playerScore[color];
+    }
 };
 
+/**
+ * @brief The move generator for the standard game board.
+ */
+using MoveGenerator = BasicMoveGenerator<BoardBase::DEFAULT_SIZE>;
+
 #endif
\ No newline at end of file
@@ -1,25 +1,91 @@
 #include "hash.h"
 
-#include <ctime>
-#include <random>
+namespace {
 
-Zobrist::Zobrist() {
+/**
+ * @brief Advances a SplitMix64 generator.
+ * @param state The generator state.
+ * @return The next random number.
+ */
+constexpr unsigned long long splitMix64(unsigned long long &state) {
+    unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+template <int N>
+constexpr typename BasicZobrist<N>::Keys makeKeys(unsigned long long seed) {
+    typename BasicZobrist<N>::Keys keys{};
     for (int i = 0; i < 2; i++) {
-        for (int x = 0; x < Board::BOARD_SIZE; x++) {
-            for (int y = 0; y < Board::BOARD_SIZE; y++) {
-                m_hashTable[i][x][y] = generateRandomNumber();
+        for (int x = 0; x < N; x++) {
+            for (int y = 0; y < N; y++) {
+                keys.table[i][x][y][0] = splitMix64(seed);
             }
         }
     }
-    m_boardHash = generateRandomNumber();
+    keys.empty = splitMix64(seed);
+
+    // a piece on (x, y) is a piece on the mapped cell in the symmetric image
+    for (int i = 0; i < 2; i++) {
+        for (int x = 0; x < N; x++) {
+            for (int y = 0; y < N; y++) {
+                for (int s = 1; s < ZobristBase::CNT_SYMMETRIES; s++) {
+                    int tx = x, ty = y;
+                    BasicZobrist<N>::transform(tx, ty, s);
+                    keys.table[i][x][y][s] = keys.table[i][tx][ty][0];
+                }
+            }
+        }
+    }
+    return keys;
 }
 
-unsigned long long Zobrist::generateRandomNumber() {
-    static std::mt19937 mt(time(NULL));
-    static std::uniform_int_distribution<unsigned long long> dist(0, UINT64_MAX);
-    return dist(mt);
+}  // namespace
+
+// constant-initialized, so no work is done at startup
+template <int N>
+typename BasicZobrist<N>::Keys BasicZobrist<N>::s_keys = makeKeys<N>(DEFAULT_SEED);
+
+void ZobristBase::setSeed(unsigned long long seed) {
+#define RESEED(N) BasicZobrist<N>::s_keys = makeKeys<N>(seed);
+    GOMOKU_FOR_EACH_BOARD_SIZE(RESEED)
+#undef RESEED
 }
 
-void Zobrist::update(int x, int y, Board::PIECE_COLOR color) {
-    m_boardHash ^= m_hashTable[color][x][y];
+template <int N>
+unsigned long long BasicZobrist<N>::checksum() {
+    // FNV-1a over the keys; the symmetric copies follow from the identity keys
+    unsigned long long sum = 14695981039346656037ULL;
+    for (int i = 0; i < 2; i++) {
+        for (int x = 0; x < N; x++) {
+            for (int y = 0; y < N; y++) {
+                sum = (sum ^ s_keys.table[i][x][y][0]) * 1099511628211ULL;
+            }
+        }
+    }
+    return (sum ^ s_keys.empty) * 1099511628211ULL;
+}
+
+template <int N>
+BasicZobrist<N>::BasicZobrist() {
+    for (int s = 0; s < CNT_SYMMETRIES; s++) m_hashes[s] = s_keys.empty;
+}
+
+template <int N>
+void BasicZobrist<N>::update(int x, int y, BoardBase::PIECE_COLOR color) {
+    const unsigned long long *keys = s_keys.table[color][x][y];
+    for (int s = 0; s < CNT_SYMMETRIES; s++) m_hashes[s] ^= keys[s];
 }
+
+template <int N>
+unsigned long long BasicZobrist<N>::getCanonicalHash(int &symmetry) const {
+    symmetry = 0;
+    for (int s = 1; s < CNT_SYMMETRIES; s++) {
+        if (m_hashes[s] < m_hashes[symmetry]) symmetry = s;
+    }
+    return m_hashes[symmetry];
+}
+
+#define INSTANTIATE(N) template class BasicZobrist<N>;
+GOMOKU_FOR_EACH_BOARD_SIZE(INSTANTIATE)
@@ -4,21 +4,62 @@
 #include "board.h"
 
 /**
- * @class Zobrist
+ * @class ZobristBase
+ * @brief The parts of Zobrist hashing shared by all board sizes.
+ */
+class ZobristBase {
+   public:
+    /**
+     * @brief The number of symmetries of the board.
+     */
+    const static int CNT_SYMMETRIES = 8;
+
+    /**
+     * @brief Regenerates the keys of every board size from another seed.
+     * @note Must be called before any board is created. Searches are reproducible for
+     * a given seed.
+     * @param seed The seed to generate the keys from.
+     */
+    static void setSeed(unsigned long long seed);
+
+    /**
+     * @brief The seed of the default keys.
+     */
+    const static unsigned long long DEFAULT_SEED = 0x676F6D6F6B75ULL;
+};
+
+/**
+ * @class BasicZobrist
  * @brief Class for generating and updating Zobrist hash values for a game board.
+ *
+ * @tparam N The size of the board.
  */
-class Zobrist {
+template <int N>
+class BasicZobrist : public ZobristBase {
    public:
     /**
-     * @brief Generates a random number for Zobrist hashing.
-     * @return The generated random number.
+     * @struct Keys
+     * @brief The random numbers used for Zobrist hashing.
+     */
+    struct Keys {
+        unsigned long long table[2][N][N][CNT_SYMMETRIES]; /**< Number of each piece on
+                                                              each cell, followed by the
+                                                              numbers of the cells it maps
+                                                              to under each symmetry. */
+        unsigned long long empty; /**< Hash value of the empty board. */
+    };
+
+    /**
+     * @brief Gets a checksum of the keys, so that hashes saved to files can be checked
+     * against the keys in use.
+     * @return The checksum.
      */
-    static unsigned long long generateRandomNumber();
+    static unsigned long long checksum();
 
     /**
-     * @brief Constructs a Zobrist object.
+     * @brief Constructs a BasicZobrist object.
      */
-    Zobrist();
+    BasicZobrist();
 
     /**
      * @brief Updates the Zobrist hash value based on the given move.
@@ -26,19 +67,69 @@ class Zobrist {
      * @param y The y-coordinate of the move.
      * @param color The color of the piece placed on the board.
      */
-    void update(int x, int y, Board::PIECE_COLOR color);
+    void update(int x, int y, BoardBase::PIECE_COLOR color);
 
     /**
      * @brief Gets the current Zobrist hash value of the game board.
      * @return The Zobrist hash value.
      */
-    unsigned long long getBoardHash() const { return m_boardHash; }
+    unsigned long long getBoardHash() const { return m_hashes[0]; }
+
+    /**
+     * @brief Gets the smallest hash value among the symmetric images of the board.
+     * @param symmetry Set to the symmetry mapping the board to the image with that hash.
+     * @return The canonical hash value.
+     */
+    unsigned long long getCanonicalHash(int &symmetry) const;
+
+    /**
+     * @brief Maps a cell by one of the symmetries of the board.
+     * @param x The x-coordinate, mapped in place.
+     * @param y The y-coordinate, mapped in place.
+     * @param symmetry The symmetry: bit 2 swaps x and y, then bit 1 mirrors x and bit 0
+     * mirrors y. 0 is the identity.
+     */
+    static constexpr void transform(int &x, int &y, int symmetry) {
+        if (symmetry & 4) {
+            int t = x;
+            x = y;
+            y = t;
+        }
+        if (symmetry & 2) x = N - 1 - x;
+        if (symmetry & 1) y = N - 1 - y;
+    }
+
+    /**
+     * @brief Maps a cell back by the inverse of one of the symmetries of the board.
+     * @param x The x-coordinate, mapped in place.
+     * @param y The y-coordinate, mapped in place.
+     * @param symmetry The symmetry.
+     */
+    static constexpr void inverseTransform(int &x, int &y, int symmetry) {
+        if (symmetry & 1) y = N - 1 - y;
+        if (symmetry & 2) x = N - 1 - x;
+        if (symmetry & 4) {
+            int t = x;
+            x = y;
+            y = t;
+        }
+    }
 
    private:
-    unsigned long long
-        m_hashTable[2][Board::BOARD_SIZE]
-                   [Board::BOARD_SIZE];  // Hash table for storing random numbers
-    unsigned long long m_boardHash;      // Current Zobrist hash value of the game board
+    friend class ZobristBase;
+
+    /**
+     * @brief The keys, generated at compile time from DEFAULT_SEED unless reseeded.
+     */
+    static Keys s_keys;
+
+    // hash values of the symmetric images of the game board, the identity first
+    unsigned long long m_hashes[CNT_SYMMETRIES];
 };
 
-#endif
\ No newline at end of file
+/**
+ * @brief Zobrist hashing for the standard game board.
+ */
+using Zobrist = BasicZobrist<BoardBase::DEFAULT_SIZE>;
+
+#endif
@@ -2,71 +2,57 @@
 
 #include <iostream>
 
-#include "json.h"
-
-Judger::MODE Judger::JUDGER_MODE = Judger::MODE::COMMAND_LINE;
+#include "protocol.h"
 
 Judger::~Judger() {
     if (m_pBoard != nullptr) delete m_pBoard;
     if (m_pCore != nullptr) delete m_pCore;
 }
 
-void Judger::initGameByJSON() {
+bool Judger::initGameByJSON() {
     std::string str;
     getline(std::cin, str);
-    Json::Reader reader;
-    Json::Value input;
-    reader.parse(str, input);
 
+    // a partly read game would be searched as a different position
     Board::PIECE_COLOR coreColor = Board::PIECE_COLOR::WHITE;
-    if (input["requests"][0u]["x"].asInt() == -1 &&
-        input["requests"][0u]["y"].asInt() == -1) {
-        coreColor = Board::PIECE_COLOR::BLACK;
+    if (!Protocol::readGame(str, m_pBoard, coreColor)) {
+        std::cerr << "Invalid game request. Abort." << std::endl;
+        return false;
     }
-    Board::PIECE_COLOR opponentColor = static_cast<Board::PIECE_COLOR>(coreColor ^ 1);
 
-    int turnID = input["responses"].size();
+    m_pCore = new Core(m_pBoard, coreColor, m_config);
+    return true;
+}
 
-    if (coreColor == Board::PIECE_COLOR::WHITE) {
-        for (int i = 0; i < turnID; i++) {
-            m_pBoard->placeAt(input["requests"][i]["x"].asInt(),
-                              input["requests"][i]["y"].asInt(), opponentColor);
-            m_pBoard->placeAt(input["responses"][i]["x"].asInt(),
-                              input["responses"][i]["y"].asInt(), coreColor);
-        }
-        m_pBoard->placeAt(input["requests"][turnID]["x"].asInt(),
-                          input["requests"][turnID]["y"].asInt(), opponentColor);
-    } else {
-        m_pBoard->placeAt(input["responses"][0u]["x"].asInt(),
-                          input["responses"][0u]["y"].asInt(), coreColor);
-        for (int i = 1; i < turnID; i++) {
-            m_pBoard->placeAt(input["requests"][i]["x"].asInt(),
-                              input["requests"][i]["y"].asInt(), opponentColor);
-            m_pBoard->placeAt(input["responses"][i]["x"].asInt(),
-                              input["responses"][i]["y"].asInt(), coreColor);
-        }
-        m_pBoard->placeAt(input["requests"][turnID]["x"].asInt(),
-                          input["requests"][turnID]["y"].asInt(), opponentColor);
+bool Judger::readOpponentMoveByJSON() {
+    std::string str;
+    if (!getline(std::cin, str)) return false;
+
+    // the full history is only sent on the first turn, later turns carry the request
+    // itself
+    MoveGenerator::Move move;
+    if (!Protocol::readMove(str, move)) return false;
+    if (m_pBoard->getState(move.x, move.y) != Board::BOARD_STATE::UNPLACE) {
+        std::cerr << "Invalid opponent move " << move.x << " " << move.y << ". Abort."
+                  << std::endl;
+        return false;
     }
-
-    m_pCore = new Core(m_pBoard, coreColor);
+    Board::PIECE_COLOR opponentColor =
+        static_cast<Board::PIECE_COLOR>(m_pCore->color() ^ 1);
+    m_pCore->makeMove(move.x, move.y, opponentColor);
+    return true;
 }
 
 void Judger::printCoreMoveByJSON() {
-    Json::Value ret;
-    MoveGenerator::Move best = m_pCore->bestMove();
-    ret["response"]["x"] = best.x;
-    ret["response"]["y"] = best.y;
-    Json::FastWriter writer;
-    std::cout << writer.write(ret) << std::endl;
+    std::cout << Protocol::writeResponse(m_pCore->bestMove()) << std::endl;
 }
 
-void Judger::startGame() {
+bool Judger::startGame() {
     if (m_pBoard != nullptr) delete m_pBoard;
     m_pBoard = new Board();
     if (m_pCore != nullptr) delete m_pCore;
 
-    if (Judger::JUDGER_MODE == MODE::COMMAND_LINE) {
+    if (m_mode == MODE::COMMAND_LINE) {
         int color = -1;
         while (color != Board::PIECE_COLOR::WHITE && color != Board::PIECE_COLOR::BLACK) {
             std::cout << "Choose your color (white/black):\n";
@@ -79,14 +65,20 @@ void Judger::startGame() {
         Board::PIECE_COLOR playerColor = static_cast<Board::PIECE_COLOR>(color);
         Board::PIECE_COLOR coreColor = static_cast<Board::PIECE_COLOR>(color ^ 1);
 
-        m_pCore = new Core(m_pBoard, coreColor);
+        m_pCore = new Core(m_pBoard, coreColor, m_config);
 
         m_pBoard->display();
+        int ponderTime = -1;
+        MoveGenerator::Move predicted;
         for (int i = 0, hand = Board::PIECE_COLOR::BLACK;
              i < Board::BOARD_SIZE * Board::BOARD_SIZE; i++, hand ^= 1) {
             if (hand == coreColor) {
-                m_pCore->initTimer();
-                int tm = m_pCore->run();
+                int tm = ponderTime;
+                if (tm < 0) {
+                    m_pCore->initTimer();
+                    tm = m_pCore->run();
+                }
+                ponderTime = -1;
                 std::cout << "Run time: " << tm << "ms\n";
                 std::cout << "Best score: " << m_pCore->bestScore() << std::endl;
                 MoveGenerator::Move best = m_pCore->bestMove();
@@ -94,13 +86,21 @@ void Judger::startGame() {
                           << std::endl;
                 if (m_pBoard->getState(best.x, best.y) == Board::BOARD_STATE::INVALID) {
                     std::cout << "Invalid move. Abort.\n";
-                    return;
+                    return true;
                 }
                 m_pCore->makeMove(best.x, best.y, coreColor);
                 m_pBoard->display();
                 if (checkFiveAt(best.x, best.y, coreColor)) {
                     std::cout << "Your loose.\n";
-                    return;
+                    return true;
+                }
+
+                predicted = m_pCore->ponderMove();
+                if (m_config.ponder &&
+                    m_pBoard->getState(predicted.x, predicted.y) == Board::UNPLACE) {
+                    std::cout << "Pondering on: " << predicted.x << " " << predicted.y
+                              << std::endl;
+                    m_pCore->startPondering(predicted);
                 }
                 continue;
             }
@@ -109,57 +109,85 @@ void Judger::startGame() {
                 int x = -1, y = -1;
                 std::cout << "Your drop position: ";
                 std::cin >> x >> y;
-                while (m_pBoard->getState(x, y) != Board::BOARD_STATE::UNPLACE) {
-                    std::cout << "Invalid drop position.\n";
-                    std::cout << "Your drop position: ";
-                    std::cin >> x >> y;
+
+                if (m_pCore->isPondering()) {
+                    // on a ponder hit the predicted move is already on the board and
+                    // the search goes on
+                    if (x == predicted.x && y == predicted.y) {
+                        ponderTime = m_pCore->ponderHit();
+                    } else {
+                        m_pCore->stopPondering();
+                    }
+                }
+
+                if (ponderTime < 0) {
+                    while (m_pBoard->getState(x, y) != Board::BOARD_STATE::UNPLACE ||
+                           (playerColor == Board::PIECE_COLOR::BLACK &&
+                            m_pCore->moveGenerator().isForbidden({x, y}))) {
+                        std::cout << "Invalid drop position.\n";
+                        std::cout << "Your drop position: ";
+                        std::cin >> x >> y;
+                    }
+                    m_pCore->makeMove(x, y, playerColor);
                 }
-                m_pCore->makeMove(x, y, playerColor);
                 m_pBoard->display();
                 if (checkFiveAt(x, y, playerColor)) {
                     std::cout << "Your win.\n";
-                    return;
+                    return true;
                 }
                 continue;
             }
         }
         std::cout << "Draw.\n";
-        return;
+        return true;
     }
 
-    if (Judger::JUDGER_MODE == MODE::ONLINE_JUDGE) {
-        initGameByJSON();
+    if (m_mode == MODE::ONLINE_JUDGE) {
+        if (!initGameByJSON()) return false;
         m_pCore->run();
         printCoreMoveByJSON();
-        return;
+        // the process ends after each turn; the next one warm-starts from the file
+        m_pCore->saveTT();
+        return true;
+    }
+
+    if (m_mode == MODE::KEEP_RUNNING) {
+        // keep the core, its move generator and TT warm between turns
+        if (!initGameByJSON()) return false;
+        do {
+            m_pCore->initTimer();
+            m_pCore->run();
+            printCoreMoveByJSON();
+            std::cout << ">>>BOTZONE_REQUEST_KEEP_RUNNING<<<" << std::endl;
+
+            // with no move left the game is over, so there is no next turn to play
+            MoveGenerator::Move best = m_pCore->bestMove();
+            if (m_pBoard->getState(best.x, best.y) != Board::BOARD_STATE::UNPLACE) {
+                std::cerr << "No move available. Abort." << std::endl;
+                return true;
+            }
+            m_pCore->makeMove(best.x, best.y, m_pCore->color());
+        } while (readOpponentMoveByJSON());
+        return true;
     }
+    return true;
 }
 
 bool Judger::checkFiveAt(int x, int y, Board::PIECE_COLOR color) {
     if (m_pBoard->getState(x, y) != color) return false;
 
     for (int k = 0; k < 4; k++) {
-        int cnt = 0;
-        int ti = x, tj = y;
-        for (int s = 1; s <= 4; s++) {
-            ti += Board::dr[k];
-            tj += Board::dc[k];
-            if (ti < 0 || ti >= Board::BOARD_SIZE || tj < 0 || tj >= Board::BOARD_SIZE)
-                break;
-            if (m_pBoard->getState(ti, tj) != color) break;
-            cnt++;
-        }
-        if (cnt >= 4) return true;
-        ti = x, tj = y;
-        for (int s = 1; s <= 4; s++) {
-            ti -= Board::dr[k];
-            tj -= Board::dc[k];
-            if (ti < 0 || ti >= Board::BOARD_SIZE || tj < 0 || tj >= Board::BOARD_SIZE)
-                break;
-            if (m_pBoard->getState(ti, tj) != color) break;
-            cnt++;
-            if (cnt >= 4) return true;
+        // count the whole row, an overline does not win for every rule
+        int cnt = 1;
+        for (int sign = -1; sign <= 1; sign += 2) {
+            int ti = x + sign * Board::dr[k], tj = y + sign * Board::dc[k];
+            while (m_pBoard->getState(ti, tj) == m_pBoard->getState(x, y)) {
+                cnt++;
+                ti += sign * Board::dr[k];
+                tj += sign * Board::dc[k];
+            }
         }
+        if (Rule::isWin(m_config.rule, color, cnt)) return true;
     }
     return false;
 }
\ No newline at end of file
@@ -10,18 +10,16 @@
  */
 class Judger {
    public:
-    enum MODE { ONLINE_JUDGE = 0, COMMAND_LINE = 1 };
+    enum MODE { ONLINE_JUDGE = 0, COMMAND_LINE = 1, KEEP_RUNNING = 2 };
 
     /**
-     * @brief Sets the mode of the Judger.
-     * @param mode The mode to set (either ONLINE_JUDGE or COMMAND_LINE).
+     * @brief Constructs a Judger.
+     * @param mode The mode (ONLINE_JUDGE, COMMAND_LINE or KEEP_RUNNING).
+     * @param config The settings of the core, whose ponder flag enables pondering in
+     * command line mode.
      */
-    static void setMode(MODE mode) { JUDGER_MODE = mode; }
-
-    /**
-     * @brief Default constructor for Judger.
-     */
-    Judger() = default;
+    explicit Judger(MODE mode = COMMAND_LINE, const EngineConfig &config = EngineConfig())
+        : m_mode(mode), m_config(config) {}
 
     /**
      * @brief Destructor for Judger.
@@ -35,30 +33,36 @@ class Judger {
 
     /**
      * @brief Initializes the game by reading JSON input.
+     * @return False if the input is not a valid game, reported on stderr.
      */
-    void initGameByJSON();
+    bool initGameByJSON();
+
+    /**
+     * @brief Reads the opponent's next move as a single JSON request and plays it.
+     * @return True if a move was read and played, false on end of input or a move off
+     * the board or on an occupied cell.
+     */
+    bool readOpponentMoveByJSON();
 
     /**
      * @brief Starts the game.
+     * @return False if the JSON input of the game is invalid.
      */
-    void startGame();
+    bool startGame();
 
     /**
-     * @brief Checks if there are five pieces of the same color in a row, column, or
-     * diagonal starting from the given position.
+     * @brief Checks if there is a winning row of pieces of the same color in a row,
+     * column, or diagonal through the given position, see Rule::isWin.
      * @param x The x-coordinate of the starting position.
      * @param y The y-coordinate of the starting position.
      * @param color The color of the pieces to check.
-     * @return True if there are five pieces of the same color, false otherwise.
+     * @return True if the row wins under the configured rule, false otherwise.
      */
     bool checkFiveAt(int x, int y, Board::PIECE_COLOR color);
 
-    /**
-     * @brief The mode of the Judger.
-     */
-    static MODE JUDGER_MODE;
-
    private:
+    MODE m_mode;               /**< The mode of the Judger. */
+    EngineConfig m_config;     /**< The settings of the core. */
     Core *m_pCore = nullptr;   /**< The core for making moves */
     Board *m_pBoard = nullptr; /**< The board for the game  */
 };
@@ -0,0 +1,118 @@
+#include "nnue.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "simd.h"
+
+const char Network::MAGIC[8] = {'G', 'M', 'K', 'N', 'N', 'U', 'E', '\0'};
+
+namespace {
+
+// int16 rows of CNT_HIDDEN lanes vectorize to 8 AVX2 or 16 SSE2 additions
+
+GOMOKU_TARGET_CLONES
+void addRow(int16_t *values, const int16_t *row) {
+    for (int i = 0; i < Network::CNT_HIDDEN; i++) values[i] += row[i];
+}
+
+GOMOKU_TARGET_CLONES
+void subtractRow(int16_t *values, const int16_t *row) {
+    for (int i = 0; i < Network::CNT_HIDDEN; i++) values[i] -= row[i];
+}
+
+GOMOKU_TARGET_CLONES
+int clippedDot(const int16_t *values, const int8_t *weights) {
+    int sum = 0;
+    for (int i = 0; i < Network::CNT_HIDDEN; i++) {
+        int value = values[i] < 0                         ? 0
+                    : values[i] > Network::MAX_ACTIVATION ? Network::MAX_ACTIVATION
+                                                          : values[i];
+        sum += value * weights[i];
+    }
+    return sum;
+}
+
+template <typename T>
+bool readArray(FILE *file, std::vector<T> &array, size_t size) {
+    array.resize(size);
+    return fread(array.data(), sizeof(T), size, file) == size;
+}
+
+/**
+ * @brief Continues an FNV-1a checksum with the values of an array.
+ */
+template <typename T>
+uint64_t addChecksum(uint64_t sum, const std::vector<T> &array) {
+    for (T value : array) sum = (sum ^ (uint64_t)(int64_t)value) * 1099511628211ULL;
+    return sum;
+}
+
+}  // namespace
+
+template <int N>
+bool Network::load(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+
+    Header header;
+    std::vector<int16_t> biases, weights;
+    std::vector<int8_t> outputWeights;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 &&
+              header.version == VERSION && header.boardSize == N &&
+              header.cntHidden == CNT_HIDDEN && readArray(file, biases, CNT_HIDDEN) &&
+              readArray(file, weights, (size_t)2 * N * N * CNT_HIDDEN) &&
+              readArray(file, outputWeights, CNT_HIDDEN) && fgetc(file) == EOF;
+    fclose(file);
+    if (!ok) return false;
+
+    m_boardSize = N;
+    m_biases.swap(biases);
+    m_weights.swap(weights);
+    m_outputWeights.swap(outputWeights);
+    m_outputBias = header.outputBias;
+    m_outputScale = header.outputScale;
+
+    uint64_t sum = 14695981039346656037ULL;
+    std::vector<int32_t> scalars = {N, header.outputBias, header.outputScale};
+    sum = addChecksum(sum, scalars);
+    sum = addChecksum(sum, m_biases);
+    sum = addChecksum(sum, m_weights);
+    m_checksum = addChecksum(sum, m_outputWeights);
+    return true;
+}
+
+template <int N>
+void Network::refresh(Accumulator &accumulator, const BasicBoard<N> &board) const {
+    std::memcpy(accumulator.values, m_biases.data(), sizeof(accumulator.values));
+    for (int x = 0; x < N; x++) {
+        for (int y = 0; y < N; y++) {
+            BoardBase::BOARD_STATE state = board.getState(x, y);
+            if (state == BoardBase::UNPLACE) continue;
+            place(accumulator, x, y, static_cast<BoardBase::PIECE_COLOR>(state));
+        }
+    }
+}
+
+void Network::place(Accumulator &accumulator, int x, int y,
+                    BoardBase::PIECE_COLOR color) const {
+    addRow(accumulator.values, featureWeights(x, y, color));
+}
+
+void Network::unplace(Accumulator &accumulator, int x, int y,
+                      BoardBase::PIECE_COLOR color) const {
+    subtractRow(accumulator.values, featureWeights(x, y, color));
+}
+
+int Network::evaluate(const Accumulator &accumulator) const {
+    long long value = (long long)(clippedDot(accumulator.values, m_outputWeights.data()) +
+                                  m_outputBias) *
+                      m_outputScale;
+    return value > MAX_VALUE ? MAX_VALUE : value < -MAX_VALUE ? -MAX_VALUE : (int)value;
+}
+
+#define INSTANTIATE(N)                                \
+    template bool Network::load<N>(const char *path); \
+    template void Network::refresh<N>(Accumulator &, const BasicBoard<N> &) const;
+GOMOKU_FOR_EACH_BOARD_SIZE(INSTANTIATE)
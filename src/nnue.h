@@ -0,0 +1,146 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "board.h"
+
+/**
+ * @class Network
+ * @brief An efficiently updatable neural network evaluating a board from black's point
+ * of view, an alternative to the pattern scores of Scorer.
+ *
+ * The input has one feature per cell and color. Its first layer is kept as an
+ * Accumulator: the sum of the weights of the placed pieces, which a move changes by one
+ * row of weights. The output layer applies a clipped ReLU to the accumulator and takes
+ * a dot product with 8-bit weights, so an evaluation costs CNT_HIDDEN multiply-adds.
+ *
+ * The weight file is a Header followed by the int16 first-layer biases[CNT_HIDDEN], the
+ * int16 first-layer weights[2 * size * size][CNT_HIDDEN] and the int8 output
+ * weights[CNT_HIDDEN], in host byte order. Feature (x * size + y) * 2 + color is a
+ * piece of the color at (x, y).
+ */
+class Network {
+   public:
+    /**
+     * @brief The size of the accumulator.
+     */
+    const static int CNT_HIDDEN = 128;
+
+    /**
+     * @brief The largest activation of the clipped ReLU.
+     */
+    const static int MAX_ACTIVATION = 127;
+
+    /**
+     * @brief The bound of the evaluation, well below Core::INF.
+     */
+    const static int MAX_VALUE = 1 << 28;
+
+    /**
+     * @brief The magic bytes at the start of a weight file.
+     */
+    const static char MAGIC[8];
+
+    /**
+     * @brief The file format version.
+     */
+    const static uint32_t VERSION = 1;
+
+    /**
+     * @struct Header
+     * @brief The header of a weight file.
+     */
+    struct Header {
+        char magic[8];       /**< "GMKNNUE" followed by a zero byte. */
+        uint32_t version;    /**< The file format version. */
+        uint32_t boardSize;  /**< The board size the network was trained for. */
+        uint32_t cntHidden;  /**< The size of the accumulator, CNT_HIDDEN. */
+        int32_t outputBias;  /**< The bias of the output. */
+        int32_t outputScale; /**< The output is multiplied by it to get the score. */
+        uint32_t padding;    /**< Unused, zero. */
+    };
+
+    /**
+     * @struct Accumulator
+     * @brief The first layer of the network for a board.
+     */
+    struct Accumulator {
+        alignas(32) int16_t values[CNT_HIDDEN]; /**< The sums of the first layer. */
+    };
+
+    /**
+     * @brief Loads the weights from a file.
+     * @tparam N The board size the engine plays on.
+     * @param path The path of the weight file.
+     * @return True if the file was read and fits the board size, false otherwise.
+     */
+    template <int N>
+    bool load(const char *path);
+
+    /**
+     * @brief Computes the accumulator of a board from scratch.
+     * @param accumulator The accumulator.
+     * @param board The board.
+     */
+    template <int N>
+    void refresh(Accumulator &accumulator, const BasicBoard<N> &board) const;
+
+    /**
+     * @brief Updates the accumulator for a placed piece.
+     * @param accumulator The accumulator.
+     * @param x The x-coordinate of the piece.
+     * @param y The y-coordinate of the piece.
+     * @param color The color of the piece.
+     */
+    void place(Accumulator &accumulator, int x, int y, BoardBase::PIECE_COLOR color) const;
+
+    /**
+     * @brief Updates the accumulator for a removed piece.
+     * @param accumulator The accumulator.
+     * @param x The x-coordinate of the piece.
+     * @param y The y-coordinate of the piece.
+     * @param color The color of the piece.
+     */
+    void unplace(Accumulator &accumulator, int x, int y,
+                 BoardBase::PIECE_COLOR color) const;
+
+    /**
+     * @brief Evaluates a board from its accumulator.
+     * @param accumulator The accumulator.
+     * @return The score from black's point of view, within [-MAX_VALUE, MAX_VALUE].
+     */
+    int evaluate(const Accumulator &accumulator) const;
+
+    /**
+     * @brief Gets the board size of the loaded network.
+     * @return The board size, 0 if nothing is loaded.
+     */
+    int boardSize() const { return m_boardSize; }
+
+    /**
+     * @brief Gets a checksum of the loaded weights, which identifies the network in
+     * saved TT files.
+     * @return The checksum, 0 if nothing is loaded.
+     */
+    uint64_t checksum() const { return m_checksum; }
+
+   private:
+    /**
+     * @brief Gets the first-layer weights of a feature.
+     */
+    const int16_t *featureWeights(int x, int y, BoardBase::PIECE_COLOR color) const {
+        return &m_weights[((x * m_boardSize + y) * 2 + color) * CNT_HIDDEN];
+    }
+
+    int m_boardSize = 0;                 /**< The board size of the loaded network. */
+    std::vector<int16_t> m_biases;       /**< The first-layer biases. */
+    std::vector<int16_t> m_weights;      /**< The first-layer weights by feature. */
+    std::vector<int8_t> m_outputWeights; /**< The output weights. */
+    int m_outputBias = 0;                /**< The output bias. */
+    int m_outputScale = 1;               /**< The output scale. */
+    uint64_t m_checksum = 0;             /**< The checksum of the loaded weights. */
+};
+
+#endif
@@ -0,0 +1,239 @@
+#include "protocol.h"
+
+#include <cstring>
+
+namespace {
+
+/**
+ * @class Cursor
+ * @brief A position in the JSON text being scanned.
+ */
+class Cursor {
+   public:
+    Cursor(const char *begin, const char *end) : m_p(begin), m_end(end) {}
+
+    /**
+     * @brief Skips whitespace and consumes the given character if it comes next.
+     */
+    bool consume(char c) {
+        skipSpace();
+        if (m_p == m_end || *m_p != c) return false;
+        m_p++;
+        return true;
+    }
+
+    /**
+     * @brief Reads a string without escape sequences, pointing into the text.
+     */
+    bool readKey(const char *&key, int &length) {
+        if (!consume('"')) return false;
+        key = m_p;
+        while (m_p != m_end && *m_p != '"') {
+            if (*m_p == '\\') return false;
+            m_p++;
+        }
+        if (m_p == m_end) return false;
+        length = m_p++ - key;
+        return true;
+    }
+
+    bool readInt(int &value) {
+        skipSpace();
+        bool negative = m_p != m_end && *m_p == '-';
+        if (negative) m_p++;
+        if (m_p == m_end || *m_p < '0' || *m_p > '9') return false;
+        value = 0;
+        while (m_p != m_end && *m_p >= '0' && *m_p <= '9') value = value * 10 + *m_p++ - '0';
+        if (negative) value = -value;
+        return true;
+    }
+
+    /**
+     * @brief Skips a value of any type.
+     */
+    bool skipValue() {
+        skipSpace();
+        if (m_p == m_end) return false;
+        if (*m_p == '"') return skipString();
+        if (*m_p != '{' && *m_p != '[') {
+            while (m_p != m_end && !std::strchr(",}] \t\r\n", *m_p)) m_p++;
+            return true;
+        }
+
+        int depth = 0;
+        while (m_p != m_end) {
+            if (*m_p == '"') {
+                if (!skipString()) return false;
+                continue;
+            }
+            if (*m_p == '{' || *m_p == '[') depth++;
+            if (*m_p == '}' || *m_p == ']') depth--;
+            m_p++;
+            if (depth == 0) return true;
+        }
+        return false;
+    }
+
+   private:
+    void skipSpace() {
+        while (m_p != m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n'))
+            m_p++;
+    }
+
+    bool skipString() {
+        for (m_p++; m_p != m_end; m_p++) {
+            if (*m_p == '\\') {
+                if (++m_p == m_end) return false;
+            } else if (*m_p == '"') {
+                m_p++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const char *m_p;   ///< The next character to scan.
+    const char *m_end; ///< The end of the text.
+};
+
+bool isKey(const char *key, int length, const char *expected) {
+    return length == (int)std::strlen(expected) && std::strncmp(key, expected, length) == 0;
+}
+
+/**
+ * @brief Reads {"x":...,"y":...}, skipping other keys.
+ */
+bool readMove(Cursor &cursor, MoveGenerator::Move &move) {
+    if (!cursor.consume('{')) return false;
+    if (cursor.consume('}')) return true;
+    do {
+        const char *key;
+        int length;
+        if (!cursor.readKey(key, length) || !cursor.consume(':')) return false;
+        if (isKey(key, length, "x")) {
+            if (!cursor.readInt(move.x)) return false;
+        } else if (isKey(key, length, "y")) {
+            if (!cursor.readInt(move.y)) return false;
+        } else if (!cursor.skipValue()) {
+            return false;
+        }
+    } while (cursor.consume(','));
+    return cursor.consume('}');
+}
+
+/**
+ * @brief Reads an array of moves, calling onMove(index, move) for each of them.
+ * @return False on malformed input or if onMove returns false.
+ */
+template <typename OnMove>
+bool readMoves(Cursor &cursor, OnMove onMove) {
+    if (!cursor.consume('[')) return false;
+    if (cursor.consume(']')) return true;
+    int index = 0;
+    do {
+        MoveGenerator::Move move;
+        if (!readMove(cursor, move) || !onMove(index++, move)) return false;
+    } while (cursor.consume(','));
+    return cursor.consume(']');
+}
+
+bool isOnBoard(const MoveGenerator::Move &move) {
+    return move.x >= 0 && move.x < Board::BOARD_SIZE && move.y >= 0 &&
+           move.y < Board::BOARD_SIZE;
+}
+
+/**
+ * @brief Places a move on the board. Moves off the board stand for passes and are
+ * skipped.
+ * @return False if the cell is already occupied.
+ */
+bool place(Board *pBoard, const MoveGenerator::Move &move, Board::PIECE_COLOR color) {
+    if (!isOnBoard(move)) return true;
+    if (pBoard->getState(move.x, move.y) != Board::BOARD_STATE::UNPLACE) return false;
+    pBoard->placeAt(move.x, move.y, color);
+    return true;
+}
+
+}  // namespace
+
+bool Protocol::readGame(const std::string &str, Board *pBoard,
+                        Board::PIECE_COLOR &coreColor) {
+    Cursor cursor(str.data(), str.data() + str.size());
+    if (!cursor.consume('{')) return false;
+
+    // the order of placing does not matter, so moves go onto the board as they are read
+    bool hasRequests = false;
+    coreColor = Board::PIECE_COLOR::WHITE;
+    do {
+        const char *key;
+        int length;
+        if (!cursor.readKey(key, length) || !cursor.consume(':')) return false;
+
+        if (isKey(key, length, "requests")) {
+            hasRequests = true;
+            bool ok = readMoves(cursor, [&](int index, const MoveGenerator::Move &move) {
+                // the first request is (-1, -1) if we move first
+                if (index == 0 && !isOnBoard(move)) coreColor = Board::PIECE_COLOR::BLACK;
+                return place(pBoard, move, static_cast<Board::PIECE_COLOR>(coreColor ^ 1));
+            });
+            if (!ok) return false;
+        } else if (isKey(key, length, "responses")) {
+            if (!hasRequests) return false;
+            bool ok = readMoves(cursor, [&](int, const MoveGenerator::Move &move) {
+                return place(pBoard, move, coreColor);
+            });
+            if (!ok) return false;
+        } else if (!cursor.skipValue()) {
+            return false;
+        }
+    } while (cursor.consume(','));
+
+    return hasRequests && cursor.consume('}');
+}
+
+bool Protocol::readMove(const std::string &str, MoveGenerator::Move &move) {
+    Cursor cursor(str.data(), str.data() + str.size());
+    return ::readMove(cursor, move);
+}
+
+bool Protocol::readServerRequest(const std::string &str, ServerRequest &request) {
+    Cursor cursor(str.data(), str.data() + str.size());
+    if (!cursor.consume('{')) return false;
+
+    request = ServerRequest();
+    bool hasGame = false;
+    do {
+        const char *key;
+        int length;
+        if (!cursor.readKey(key, length) || !cursor.consume(':')) return false;
+
+        if (isKey(key, length, "game")) {
+            if (!cursor.readInt(request.game)) return false;
+            hasGame = true;
+        } else if (isKey(key, length, "command")) {
+            const char *command;
+            int commandLength;
+            if (!cursor.readKey(command, commandLength)) return false;
+            request.command.assign(command, commandLength);
+        } else if (isKey(key, length, "time")) {
+            if (!cursor.readInt(request.time)) return false;
+        } else if (isKey(key, length, "move")) {
+            if (!::readMove(cursor, request.move)) return false;
+        } else if (isKey(key, length, "moves")) {
+            bool ok = readMoves(cursor, [&](int, const MoveGenerator::Move &move) {
+                request.moves.push_back(move);
+                return true;
+            });
+            if (!ok) return false;
+        } else if (!cursor.skipValue()) {
+            return false;
+        }
+    } while (cursor.consume(','));
+
+    return hasGame && !request.command.empty() && cursor.consume('}');
+}
+
+std::string Protocol::writeResponse(const MoveGenerator::Move &move) {
+    return "{\"response\":{\"x\":" + std::to_string(move.x) +
+           ",\"y\":" + std::to_string(move.y) + "}}";
+}
@@ -0,0 +1,70 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <string>
+#include <vector>
+
+#include "board.h"
+#include "generator.h"
+
+/**
+ * @class Protocol
+ * @brief Reads and writes the JSON messages of the Botzone protocol.
+ *
+ * The messages have a fixed schema, so they are scanned in place in a single pass
+ * instead of being parsed into a JSON document.
+ */
+class Protocol {
+   public:
+    /**
+     * @struct ServerRequest
+     * @brief A request to the game server, see readServerRequest.
+     */
+    struct ServerRequest {
+        int game = -1;                          /**< The id of the game. */
+        std::string command;                    /**< The command, such as "go". */
+        int time = 0;                           /**< The time in ms, 0 if absent. */
+        MoveGenerator::Move move = {-1, -1};    /**< The move of play. */
+        std::vector<MoveGenerator::Move> moves; /**< The moves of position. */
+    };
+
+    /**
+     * @brief Reads a game of the form {"requests":[...],"responses":[...]} and places
+     * every move on the board.
+     * @note "requests" must come before "responses". Other keys are skipped.
+     * @param str The JSON text.
+     * @param pBoard The board to place the moves on.
+     * @param coreColor Set to the color of the player answering the requests.
+     * @return True if the game was read, false on malformed input or a move on an
+     * occupied cell.
+     */
+    static bool readGame(const std::string &str, Board *pBoard,
+                         Board::PIECE_COLOR &coreColor);
+
+    /**
+     * @brief Reads a single move of the form {"x":...,"y":...}.
+     * @param str The JSON text.
+     * @param move Set to the move read.
+     * @return True if the move was read, false on malformed input.
+     */
+    static bool readMove(const std::string &str, MoveGenerator::Move &move);
+
+    /**
+     * @brief Reads a game server request of the form
+     * {"game":...,"command":"...","time":...,"move":{...},"moves":[...]}.
+     * @note Only "game" and "command" are required. Other keys are skipped.
+     * @param str The JSON text.
+     * @param request Set to the request read.
+     * @return True if the request was read, false on malformed input.
+     */
+    static bool readServerRequest(const std::string &str, ServerRequest &request);
+
+    /**
+     * @brief Writes a response of the form {"response":{"x":...,"y":...}}.
+     * @param move The move to respond with.
+     * @return The JSON text.
+     */
+    static std::string writeResponse(const MoveGenerator::Move &move);
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef RULE_H
+#define RULE_H
+
+#include "board.h"
+
+/**
+ * @class Rule
+ * @brief The rule sets the engine can play.
+ */
+class Rule {
+   public:
+    /**
+     * @enum TYPE
+     * @brief Enumerates the rule sets.
+     */
+    enum TYPE {
+        FREESTYLE = 0, /**< Five or more in a row wins. */
+        STANDARD = 1,  /**< Exactly five in a row wins, overlines do not count. */
+        RENJU = 2      /**< Black needs exactly five and must not make a double three,
+                          double four or overline; white wins with five or more. */
+    };
+
+    /**
+     * @brief Checks whether a player needs exactly five in a row.
+     * @param rule The rule set.
+     * @param color The color of the player.
+     * @return True if overlines do not win for the player.
+     */
+    static bool exactFive(TYPE rule, BoardBase::PIECE_COLOR color) {
+        return rule == STANDARD || (rule == RENJU && color == BoardBase::BLACK);
+    }
+
+    /**
+     * @brief Checks whether a player has forbidden moves.
+     * @param rule The rule set.
+     * @param color The color of the player.
+     * @return True if the player must not make double threes, double fours or
+     * overlines.
+     */
+    static bool hasForbidden(TYPE rule, BoardBase::PIECE_COLOR color) {
+        return rule == RENJU && color == BoardBase::BLACK;
+    }
+
+    /**
+     * @brief Checks whether a row of pieces wins.
+     * @param rule The rule set.
+     * @param color The color of the pieces.
+     * @param length The number of pieces in the row.
+     * @return True if the row wins.
+     */
+    static bool isWin(TYPE rule, BoardBase::PIECE_COLOR color, int length) {
+        return exactFive(rule, color) ? length == 5 : length >= 5;
+    }
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "scanner.h"
+
+#include <cstring>
+
+#include "scorer.h"
+#include "simd.h"
+
+namespace {
+
+#ifdef __GNUC__
+
+// 8 lanes, a single AVX2 register or two SSE2 registers
+typedef int Lanes __attribute__((vector_size(32)));
+const int CNT_LANES = sizeof(Lanes) / sizeof(int);
+
+// an out parameter, since returning a vector by value depends on the target ABI
+void load(Lanes &lanes, const int *p) { std::memcpy(&lanes, p, sizeof(lanes)); }
+
+/**
+ * @brief Computes the windows of a block of rows in one direction, branch free with a
+ * lane mask for the cells whose line has not been blocked yet.
+ */
+GOMOKU_TARGET_CLONES
+void scanLines(const int *digits, int stride, int cntRows, int cntCols, int offset,
+               int *windows) {
+    for (int x = 0; x < cntRows; x++) {
+        for (int y = 0; y < cntCols; y += CNT_LANES) {
+            const int *p = digits + x * stride + y;
+            const Lanes zero = {};
+            Lanes window = zero;
+            for (int side = -1; side <= 1; side += 2) {
+                Lanes alive = zero - 1;
+                for (int step = 1, shift = side < 0 ? 0 : 2 * Scorer::WINDOW_SIDE;
+                     step <= Scorer::WINDOW_SIDE; step++, shift += 2) {
+                    Lanes d;
+                    load(d, p + side * step * offset);
+                    alive &= d != 0;
+                    window |= (d & alive) << shift;
+                }
+            }
+            std::memcpy(windows + x * cntCols + y, &window, sizeof(window));
+        }
+    }
+}
+
+#else
+
+/**
+ * @brief Computes the window of one cell, the reference of the vector kernel.
+ * @param p The digit of the cell.
+ * @param offset The distance between neighbouring digits of the line.
+ * @return The window, laid out like BasicCore::sideWindow reads each side, see
+ * Scorer::getTypeByWindow.
+ */
+int cellWindow(const int *p, int offset) {
+    int window = 0;
+    for (int side = -1; side <= 1; side += 2) {
+        for (int step = 1, shift = side < 0 ? 0 : 2 * Scorer::WINDOW_SIDE;
+             step <= Scorer::WINDOW_SIDE && p[side * step * offset]; step++, shift += 2) {
+            window |= p[side * step * offset] << shift;
+        }
+    }
+    return window;
+}
+
+void scanLines(const int *digits, int stride, int cntRows, int cntCols, int offset,
+               int *windows) {
+    for (int x = 0; x < cntRows; x++) {
+        for (int y = 0; y < cntCols; y++) {
+            windows[x * cntCols + y] = cellWindow(digits + x * stride + y, offset);
+        }
+    }
+}
+
+#endif
+
+}  // namespace
+
+template <int N>
+void BasicLineScanner<N>::scan(const BasicBoard<N> &board, BoardBase::PIECE_COLOR player) {
+    std::memset(m_digits, 0, sizeof(m_digits));
+    for (int x = 0; x < N; x++) {
+        for (int y = 0; y < N; y++) {
+            BoardBase::BOARD_STATE state = board.getState(x, y);
+            int *digit = &m_digits[x + PADDING][y + PADDING];
+            if (state == BoardBase::UNPLACE) {
+                *digit = 2;
+            } else if (state == static_cast<BoardBase::BOARD_STATE>(player)) {
+                *digit = 1;
+            }
+        }
+    }
+
+    for (int dir = 0; dir < 4; dir++) {
+        scanLines(&m_digits[PADDING][PADDING], STRIDE, N, ROW,
+                  BoardBase::dr[dir] * STRIDE + BoardBase::dc[dir], &m_windows[dir][0][0]);
+    }
+}
+
+#define INSTANTIATE(N) template class BasicLineScanner<N>;
+GOMOKU_FOR_EACH_BOARD_SIZE(INSTANTIATE)
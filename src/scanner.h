@@ -0,0 +1,54 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include "board.h"
+
+/**
+ * @class BasicLineScanner
+ * @brief Computes the windows of every cell of a board in all four directions at once.
+ *
+ * The incremental evaluation walks the cells one at a time (Core::updateMoveAt). The
+ * scanner instead lays the board out as rows of digits and computes the windows of 8
+ * neighbouring cells per instruction, which makes evaluating a whole board from scratch
+ * cheap enough for initialization and verification. With GCC or Clang on x86-64 the
+ * kernel is built for AVX2 and the SSE2 baseline and picked at load time; other
+ * compilers get the scalar kernel.
+ *
+ * @tparam N The size of the board.
+ */
+template <int N>
+class BasicLineScanner {
+   public:
+    /**
+     * @brief The number of cells scanned per row, a multiple of the vector width.
+     */
+    const static int ROW = (N + 7) / 8 * 8;
+
+    /**
+     * @brief Computes the windows of every cell of the board for a player.
+     *
+     * The windows of occupied cells are computed as if they were empty.
+     * @param board The board.
+     * @param player The player whose lines are scanned.
+     */
+    void scan(const BasicBoard<N> &board, BoardBase::PIECE_COLOR player);
+
+    /**
+     * @brief Gets a window computed by the last scan, see Scorer::getTypeByWindow.
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param dir The direction, see BoardBase::dr and BoardBase::dc.
+     * @return The window.
+     */
+    int lineWindow(int x, int y, int dir) const { return m_windows[dir][x][y]; }
+
+   private:
+    const static int PADDING = 5; /**< Blocked cells around the board. */
+    const static int STRIDE = ROW + 2 * PADDING; /**< The row length of m_digits. */
+
+    int m_digits[N + 2 * PADDING][STRIDE]; /**< The digit of every cell: 0 blocked,
+                                              1 own piece, 2 empty. */
+    int m_windows[4][N][ROW];              /**< The windows of the last scan. */
+};
+
+#endif
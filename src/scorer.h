@@ -1,7 +1,7 @@
 #ifndef SCORER_H
 #define SCORER_H
 
-#include "board.h"
+#include "weights.h"
 
 /**
  * @class Scorer
@@ -24,35 +24,59 @@ class Scorer {
         SLEEP_THREE = 6,
         LIVE_TWO = 7,
         SLEEP_TWO = 8,
-        BASE = 9
+        BASE = 9,
+        OVERLINE = 10,   /**< Six or more in a row where only exactly five wins. */
+        DOUBLE_FOUR = 11 /**< Two fours in one line, e.g. 1211121. */
     };
 
     /**
-     * @brief Default constructor for the Scorer class.
+     * @brief Retrieves the type of a line through a move from its window.
+     *
+     * A window holds the 5 cells on each side of the move, 2 bits per cell, nearest
+     * first, the left (-dr, -dc) side in the low 10 bits: 0 for a blocked cell
+     * (opponent piece, board edge or beyond either), 1 for the player's piece and 2 for
+     * an empty cell. Fours must complete to a five through the move, threes to a four
+     * and twos to a three, so split and broken shapes are told apart in one lookup.
+     * @param window The window.
+     * @param exactFive Whether only exactly five in a row wins, see Rule::exactFive.
+     * Overlines are then OVERLINE, and two fours in one line DOUBLE_FOUR instead of
+     * LIVE_FOUR.
+     * @return The line type.
      */
-    Scorer();
+    static Type getTypeByWindow(int window, bool exactFive) {
+        return static_cast<Type>(windowTypes(exactFive)[window]);
+    }
 
     /**
-     * @brief Destructor for the Scorer class.
+     * @brief Gets the table that maps windows to line types, see getTypeByWindow.
+     * @param exactFive Whether only exactly five in a row wins.
+     * @return The table of CNT_WINDOWS types.
      */
-    ~Scorer() { delete[] m_pTypeTable; }
+    static const unsigned char *windowTypes(bool exactFive) {
+        return WINDOW_TYPES[exactFive];
+    }
 
     /**
-     * @brief Retrieves the line state type based on the given line state.
-     * @param state The line state.
-     * @return The line state type.
+     * @brief The number of cells of a window on each side of the move.
      */
-    Type getTypeByLineState(int state) const { return m_pTypeTable[state]; }
+    const static int WINDOW_SIDE = 5;
 
     /**
-     * @brief The total number of possible line states.
+     * @brief The total number of windows, including those that cannot occur.
      */
-    const static int CNT_STATES = 19683;
+    const static int CNT_WINDOWS = 1 << (4 * WINDOW_SIDE);
+
+    /**
+     * @brief The line types of the windows, free-style first and exact-five second.
+     * Generated at build time by scoretable/generate.cpp; windows that cannot occur are
+     * BASE.
+     */
+    static const unsigned char WINDOW_TYPES[2][CNT_WINDOWS];
 
     /**
      * @brief The total number of line state types.
      */
-    const static int CNT_TYPES = 10;
+    const static int CNT_TYPES = 12;
 
     /**
      * @brief The scores associated with each line state type.
@@ -60,13 +84,29 @@ class Scorer {
     const static int TYPE_SCORES[CNT_TYPES];
 
     /**
-     * @brief The base scores for each position on the game board.
+     * @brief Gets the distance of a position to the nearest edge.
+     * @param x The x-coordinate of the position.
+     * @param y The y-coordinate of the position.
+     * @param size The size of the board.
+     * @return The distance.
      */
-    const static int BASE_SCORES[Board::BOARD_SIZE][Board::BOARD_SIZE];
+    static constexpr int edgeDistance(int x, int y, int size) {
+        int dx = x < size - 1 - x ? x : size - 1 - x;
+        int dy = y < size - 1 - y ? y : size - 1 - y;
+        return dx < dy ? dx : dy;
+    }
 
-   private:
-    Type *m_pTypeTable; /**< Pointer to the table that maps line states to line state
-                           types. */
+    /**
+     * @brief Gets the base score of a position, its distance to the nearest edge times
+     * GOMOKU_BASE_WEIGHT.
+     * @param x The x-coordinate of the position.
+     * @param y The y-coordinate of the position.
+     * @param size The size of the board.
+     * @return The base score.
+     */
+    static constexpr int baseScore(int x, int y, int size) {
+        return edgeDistance(x, y, size) * GOMOKU_BASE_WEIGHT;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "server.h"
+
+#include <thread>
+
+#include "protocol.h"
+
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define min(a, b) ((a) < (b) ? (a) : (b))
+
+namespace {
+
+/**
+ * @brief Checks that a move is on the board and not played yet.
+ */
+bool isLegal(const std::vector<MoveGenerator::Move> &moves,
+             const MoveGenerator::Move &move) {
+    if (move.x < 0 || move.x >= Board::BOARD_SIZE || move.y < 0 ||
+        move.y >= Board::BOARD_SIZE) {
+        return false;
+    }
+    for (const auto &played : moves) {
+        if (played.x == move.x && played.y == move.y) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+Server::Server(const EngineConfig &config) : m_config(config) {
+    if (m_config.threads < 1) m_config.threads = 1;
+}
+
+void Server::run(std::istream &in, std::ostream &out) {
+    m_pOut = &out;
+    m_clock.recordCurrent();
+    m_done = false;
+    m_engines.assign(m_config.threads, nullptr);
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < m_config.threads; i++) {
+        workers.emplace_back(&Server::work, this, i);
+    }
+
+    std::string line;
+    while (getline(in, line)) {
+        if (line.empty()) continue;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        handle(line);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+    }
+    m_queued.notify_all();
+    for (auto &worker : workers) worker.join();
+    out.flush();
+}
+
+void Server::handle(const std::string &line) {
+    Protocol::ServerRequest request;
+    if (!Protocol::readServerRequest(line, request)) {
+        output(error(request.game, "invalid request"));
+        return;
+    }
+
+    auto it = m_games.find(request.game);
+    if (request.command == "new") {
+        if (it != m_games.end()) {
+            output(error(request.game, "game exists"));
+            return;
+        }
+        m_games[request.game].clock = request.time > 0 ? request.time : -1;
+        return;
+    }
+    if (it == m_games.end() || it->second.ended) {
+        output(error(request.game, "unknown game"));
+        return;
+    }
+    Game &game = it->second;
+
+    if (request.command == "stop" || request.command == "end") {
+        if (!game.searching) {
+            if (request.command == "end") m_games.erase(it);
+            return;
+        }
+        // a queued search starts with the shortest limit; a search that is only about
+        // to start still ends by its deadline
+        game.stopped = true;
+        game.ended = request.command == "end";
+        if (game.worker >= 0) m_engines[game.worker]->stop();
+        return;
+    }
+
+    if (game.searching) {
+        output(error(request.game, "game is searching"));
+        return;
+    }
+
+    if (request.command == "position") {
+        std::vector<Move> moves;
+        for (const auto &move : request.moves) {
+            if (!isLegal(moves, move)) {
+                output(error(request.game, "illegal move"));
+                return;
+            }
+            moves.push_back(move);
+        }
+        game.moves = moves;
+    } else if (request.command == "play") {
+        if (!isLegal(game.moves, request.move)) {
+            output(error(request.game, "illegal move"));
+            return;
+        }
+        game.moves.push_back(request.move);
+    } else if (request.command == "go") {
+        int now = m_clock.getTimePass();
+        int budget = request.time > 0 ? request.time : m_config.timeLimit;
+        if (game.clock >= 0) budget = min(budget, max(game.clock / MOVES_TO_GO, 1));
+
+        game.searching = true;
+        m_jobs.push({now + budget, now, m_cntJobs++, request.game});
+        m_queued.notify_one();
+    } else {
+        output(error(request.game, "unknown command"));
+    }
+}
+
+void Server::work(int worker) {
+    // allocated once per worker and shared by every game it searches
+    Engine engine(m_config);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_engines[worker] = &engine;
+    while (true) {
+        m_queued.wait(lock, [this]() { return m_done || !m_jobs.empty(); });
+        if (m_jobs.empty()) break;
+
+        Job job = m_jobs.top();
+        m_jobs.pop();
+        Game &game = m_games[job.game];
+        std::vector<Move> moves = game.moves;
+        Engine::Limits limits;
+        limits.time = game.stopped ? 1 : max(job.deadline - m_clock.getTimePass(), 1);
+        game.worker = worker;
+
+        lock.unlock();
+        bool valid = engine.setPosition(moves);
+        Engine::Result result;
+        if (valid) result = engine.search(limits);
+        lock.lock();
+
+        // std::map keeps references valid while other games come and go
+        int spent = m_clock.getTimePass() - job.issued;
+        game.searching = game.stopped = false;
+        game.worker = -1;
+        if (game.clock >= 0) game.clock = max(game.clock - spent, 0);
+        if (game.ended) {
+            m_games.erase(job.game);
+            continue;
+        }
+        if (!valid) {
+            output(error(job.game, "invalid position"));
+            continue;
+        }
+
+        if (result.bestMove.x != -1) game.moves.push_back(result.bestMove);
+        output("{\"game\":" + std::to_string(job.game) + ",\"response\":{\"x\":" +
+               std::to_string(result.bestMove.x) +
+               ",\"y\":" + std::to_string(result.bestMove.y) +
+               "},\"score\":" + std::to_string(result.score) +
+               ",\"depth\":" + std::to_string(result.depth) +
+               ",\"nodes\":" + std::to_string(result.nodes) +
+               ",\"time\":" + std::to_string(spent) +
+               ",\"clock\":" + std::to_string(game.clock) + "}");
+    }
+    m_engines[worker] = nullptr;
+}
+
+void Server::output(const std::string &line) {
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    *m_pOut << line << "\n";
+    m_pOut->flush();
+}
+
+std::string Server::error(int game, const char *message) {
+    return "{\"game\":" + std::to_string(game) + ",\"error\":\"" + message + "\"}";
+}
@@ -0,0 +1,126 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+#include "timer.h"
+
+/**
+ * @class Server
+ * @brief Plays many games at once on a fixed pool of engines, one JSON request per line.
+ *
+ * A game is only its moves and its clock, so games cost no TT memory. Each worker thread
+ * owns one Engine and sets it up with the position of whatever game it searches next;
+ * the TT is keyed by position, so its entries stay valid from one game to the next.
+ * Searches wait in a queue ordered by deadline, and a search that waited is given only
+ * the time left until its deadline.
+ *
+ * Requests are {"game":id,"command":...} with:
+ * - new: starts a game, with "time" the engine's total time in ms, or no clock if 0;
+ * - position: replaces the moves of a game with "moves";
+ * - play: plays "move" for the side to move;
+ * - go: searches and plays the engine's move, with "time" the limit of this move;
+ * - stop: makes a queued or running search return as soon as possible;
+ * - end: drops a game.
+ * A search is answered with {"game":id,"response":{"x":..,"y":..},...} when it ends and
+ * invalid requests with {"game":id,"error":...}, in the order they complete.
+ */
+class Server {
+   public:
+    /**
+     * @brief The number of moves the rest of a game's clock is shared among.
+     */
+    const static int MOVES_TO_GO = 20;
+
+    /**
+     * @brief Constructs a Server.
+     * @param config The settings of the engines; threads is the number of workers and
+     * timeLimit the longest search of a move.
+     */
+    explicit Server(const EngineConfig &config);
+
+    /**
+     * @brief Serves the requests of the input until it ends and every queued search is
+     * answered.
+     * @param in The input stream.
+     * @param out The output stream.
+     */
+    void run(std::istream &in, std::ostream &out);
+
+   private:
+    using Move = Engine::Move;
+
+    /**
+     * @struct Game
+     * @brief A game being played.
+     */
+    struct Game {
+        std::vector<Move> moves; ///< The moves played, black first.
+        int clock = -1;          ///< The engine's remaining time in ms, -1 for no clock.
+        bool searching = false;  ///< Whether a search is queued or running.
+        bool stopped = false;    ///< Whether the search must return at once.
+        bool ended = false;      ///< Whether the game is dropped once its search ends.
+        int worker = -1;         ///< The worker running the search, -1 if none.
+    };
+
+    /**
+     * @struct Job
+     * @brief A queued search.
+     */
+    struct Job {
+        int deadline; ///< The time by which the move is due, in ms since run().
+        int issued;   ///< The time the search was requested, in ms since run().
+        int sequence; ///< The order of the request, to break ties.
+        int game;     ///< The id of the game.
+
+        bool operator>(const Job &other) const {
+            if (deadline != other.deadline) return deadline > other.deadline;
+            return sequence > other.sequence;
+        }
+    };
+
+    /**
+     * @brief Handles a request line with m_mutex held.
+     */
+    void handle(const std::string &line);
+
+    /**
+     * @brief Searches queued jobs, the nearest deadline first, until the input ends and
+     * the queue is empty.
+     * @param worker The index of the worker.
+     */
+    void work(int worker);
+
+    /**
+     * @brief Writes a line to the output.
+     */
+    void output(const std::string &line);
+
+    /**
+     * @brief Makes an error line.
+     */
+    static std::string error(int game, const char *message);
+
+    EngineConfig m_config; ///< The settings of the engines.
+    Timer m_clock;         ///< Started when run() is called.
+
+    std::ostream *m_pOut = nullptr; ///< The output stream.
+    std::mutex m_outMutex;          ///< Guards the output stream.
+
+    std::mutex m_mutex;                 ///< Guards everything below.
+    std::condition_variable m_queued;   ///< Signalled when a job is queued or input ends.
+    std::map<int, Game> m_games;        ///< The games by id.
+    std::priority_queue<Job, std::vector<Job>, std::greater<Job>> m_jobs; ///< Searches.
+    std::vector<Engine *> m_engines;    ///< The engine of each worker.
+    int m_cntJobs = 0;                  ///< The number of searches requested.
+    bool m_done = false;                ///< Whether the input has ended.
+};
+
+#endif
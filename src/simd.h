@@ -0,0 +1,18 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+/**
+ * @brief Builds a function for AVX2 and for the baseline target, picking one when the
+ * program is loaded. Only GCC and Clang on x86-64 support it; elsewhere the function is
+ * built once for the target.
+ */
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define GOMOKU_TARGET_CLONES __attribute__((target_clones("avx2", "default")))
+#endif
+#endif
+#ifndef GOMOKU_TARGET_CLONES
+#define GOMOKU_TARGET_CLONES
+#endif
+
+#endif
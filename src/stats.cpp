@@ -0,0 +1,31 @@
+#include "stats.h"
+
+#include <cstdio>
+
+std::string SearchStats::toLogLine() const {
+    char buf[128];
+    std::string line = "{\"nodes\":" + std::to_string(nodes) +
+                       ",\"leaves\":" + std::to_string(leaves) +
+                       ",\"cutoffs\":" + std::to_string(cutoffs);
+    snprintf(buf, sizeof(buf), "%.4f",
+             cutoffs ? (double)firstMoveCutoffs / cutoffs : 0.0);
+    line += ",\"first_move_cutoff_ratio\":" + std::string(buf);
+    line += ",\"tt\":{\"probes\":" + std::to_string(tt.probes) +
+            ",\"hits\":" + std::to_string(tt.hits) +
+            ",\"cutoffs\":" + std::to_string(tt.cutoffs) +
+            ",\"overwrites\":" + std::to_string(tt.overwrites) + "}";
+
+    line += ",\"iterations\":[";
+    for (size_t i = 0; i < iterations.size(); i++) {
+        const Iteration &iteration = iterations[i];
+        snprintf(buf, sizeof(buf), "%.3f", iteration.branching);
+        if (i) line += ",";
+        line += "{\"depth\":" + std::to_string(iteration.depth) +
+                ",\"nodes\":" + std::to_string(iteration.nodes) +
+                ",\"time\":" + std::to_string(iteration.time) +
+                ",\"branching\":" + buf +
+                ",\"complete\":" + (iteration.complete ? "true" : "false") + "}";
+    }
+    line += "]}";
+    return line;
+}
@@ -0,0 +1,59 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs the statement only when search statistics are enabled at compile time
+ * (GOMOKU_STATS), so that disabled statistics cost nothing.
+ */
+#ifdef GOMOKU_STATS
+#define STATS(...) __VA_ARGS__
+#else
+#define STATS(...)
+#endif
+
+/**
+ * @struct TTStats
+ * @brief Counters of transposition table accesses.
+ */
+struct TTStats {
+    long long probes = 0;     /**< Number of lookups. */
+    long long hits = 0;       /**< Lookups finding an entry of the same position. */
+    long long cutoffs = 0;    /**< Lookups returning a usable value. */
+    long long overwrites = 0; /**< Insertions replacing another position's entry. */
+};
+
+/**
+ * @struct SearchStats
+ * @brief Statistics of one search.
+ */
+struct SearchStats {
+    /**
+     * @struct Iteration
+     * @brief Statistics of one iteration of iterative deepening.
+     */
+    struct Iteration {
+        int depth = 0;         /**< Search depth of the iteration. */
+        long long nodes = 0;   /**< Nodes visited by the iteration. */
+        int time = 0;          /**< Time spent on the iteration in milliseconds. */
+        double branching = 0;  /**< Effective branching factor per ply. */
+        bool complete = false; /**< Whether the iteration finished in time. */
+    };
+
+    long long nodes = 0;            /**< Number of visited nodes. */
+    long long leaves = 0;           /**< Number of leaf evaluations. */
+    long long cutoffs = 0;          /**< Number of beta cutoffs after searching moves. */
+    long long firstMoveCutoffs = 0; /**< Beta cutoffs caused by the first move. */
+    TTStats tt;                     /**< Transposition table counters. */
+    std::vector<Iteration> iterations; /**< Per iteration statistics. */
+
+    /**
+     * @brief Formats the statistics as a single JSON line.
+     * @return The log line.
+     */
+    std::string toLogLine() const;
+};
+
+#endif
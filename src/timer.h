@@ -1,25 +1,31 @@
 #ifndef TIMER_H
 #define TIMER_H
 
+#include <atomic>
 #include <chrono>
 
 class Timer {
    public:
-    Timer() { m_preTime = std::chrono::high_resolution_clock::now(); }
+    Timer() { recordCurrent(); }
 
-    void recordCurrent() { m_preTime = std::chrono::high_resolution_clock::now(); }
+    // the recorded time point is atomic so that a search running in another thread can
+    // be re-timed while it is running
+    void recordCurrent() {
+        m_preTime = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    }
 
     int getTimePass() const {
         auto now = std::chrono::high_resolution_clock::now();
-        auto duration =
-            std::chrono::duration_cast<std::chrono::milliseconds>(now - m_preTime);
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - std::chrono::high_resolution_clock::time_point(
+                      std::chrono::high_resolution_clock::duration(m_preTime.load())));
         return duration.count();
     }
 
     const static int TIME_OUT = __INT32_MAX__;
 
    private:
-    std::chrono::high_resolution_clock::time_point m_preTime;
+    std::atomic<std::chrono::high_resolution_clock::rep> m_preTime;
 };
 
-#endif
\ No newline at end of file
+#endif
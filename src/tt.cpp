@@ -1,33 +1,65 @@
 #include "tt.h"
 
-TT::TT() {
-    m_pTable[0] = new Item[LENGTH];
-    m_pTable[1] = new Item[LENGTH];
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "hash.h"
+
+namespace {
+
+const char FILE_MAGIC[8] = {'G', 'M', 'K', 'T', 'T', '\0', '\0', '\0'};
+
+}  // namespace
+
+TT::TT(int cntBits) : m_length(1 << cntBits) {
+    // calloc hands out fresh zero pages, so the table is only touched when used
+    m_pTable[0] = static_cast<Item *>(calloc(m_length, sizeof(Item)));
+    m_pTable[1] = static_cast<Item *>(calloc(m_length, sizeof(Item)));
+}
+
+int TT::bitsForSize(int megabytes) {
+    long long cntEntries = ((long long)megabytes << 20) / (2 * sizeof(Item));
+    int cntBits = 10;
+    while (cntBits < 30 && (2LL << cntBits) <= cntEntries) cntBits++;
+    return cntBits;
 }
 
 TT::~TT() {
-    delete[] m_pTable[0];
-    delete[] m_pTable[1];
+    free(m_pTable[0]);
+    free(m_pTable[1]);
 }
 
 int TT::find(unsigned long long hash, int depth, int alpha, int beta,
-             Board::PIECE_COLOR color) const {
+             BoardBase::PIECE_COLOR color) const {
     int idx = getHashIndex(hash);
 
     Item &item = m_pTable[color][idx];
 
+    STATS(m_stats.probes++;)
     if (item.flag == EMPTY) return TT_NOT_HIT;
 
+    STATS(if (item.hash == hash) m_stats.hits++;)
     if (item.hash == hash && item.depth >= depth) {
         switch (item.flag) {
             case EXACT:
+                STATS(m_stats.cutoffs++;)
                 return item.value;
             case LOWER:
                 // val >= beta, the opponent will not choose this node
+                STATS(if (item.value >= beta) m_stats.cutoffs++;)
                 if (item.value >= beta) return item.value;
                 break;
             case UPPER:
                 // val <= alpha, we will not choose this node
+                STATS(if (item.value <= alpha) m_stats.cutoffs++;)
                 if (item.value <= alpha) return item.value;
                 break;
             default:
@@ -39,14 +71,111 @@ int TT::find(unsigned long long hash, int depth, int alpha, int beta,
 }
 
 void TT::insert(unsigned long long hash, int depth, int value, Flag flag,
-                Board::PIECE_COLOR color) {
+                BoardBase::PIECE_COLOR color) {
     int idx = getHashIndex(hash);
 
     Item &item = m_pTable[color][idx];
 
+    STATS(if (item.flag != EMPTY && item.hash != hash) m_stats.overwrites++;)
+
     // always replace the entry
     item.depth = depth;
     item.hash = hash;
     item.value = value;
     item.flag = flag;
-}
\ No newline at end of file
+}
+
+template <int N>
+bool TT::save(const char *path, int minDepth, const Signature &signature) const {
+    std::vector<FileRecord> records;
+    for (int color = 0; color < 2; color++) {
+        for (int idx = 0; idx < m_length; idx++) {
+            const Item &item = m_pTable[color][idx];
+            if (item.flag == EMPTY || item.depth < minDepth) continue;
+
+            FileRecord record = {};
+            record.hash = item.hash;
+            record.value = item.value;
+            record.depth = item.depth;
+            record.flag = item.flag;
+            record.color = color;
+            records.push_back(record);
+        }
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+    header.version = FILE_VERSION;
+    header.boardSize = N;
+    header.keyCheck = BasicZobrist<N>::checksum();
+    header.signature = signature;
+    header.cntRecords = records.size();
+
+    std::string tmpPath = std::string(path) + ".XXXXXX";
+    int fd = mkstemp(&tmpPath[0]);
+    if (fd < 0) return false;
+    fchmod(fd, 0644);
+    FILE *file = fdopen(fd, "wb");
+    if (!file) {
+        close(fd);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(records.data(), sizeof(FileRecord), records.size(), file) ==
+                  records.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(tmpPath.c_str(), path) != 0) {
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+template <int N>
+int TT::load(const char *path, const Signature &signature) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(FileHeader)) {
+        close(fd);
+        return -1;
+    }
+    void *pData = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pData == MAP_FAILED) return -1;
+
+    const FileHeader *pHeader = static_cast<const FileHeader *>(pData);
+    if (std::memcmp(pHeader->magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        pHeader->version != FILE_VERSION || pHeader->boardSize != N ||
+        pHeader->keyCheck != BasicZobrist<N>::checksum() ||
+        std::memcmp(&pHeader->signature, &signature, sizeof(Signature)) != 0 ||
+        pHeader->cntRecords > (st.st_size - sizeof(FileHeader)) / sizeof(FileRecord)) {
+        munmap(pData, st.st_size);
+        return -1;
+    }
+
+    const FileRecord *pRecords = reinterpret_cast<const FileRecord *>(pHeader + 1);
+    int cntRecords = pHeader->cntRecords;
+    for (int i = 0; i < cntRecords; i++) {
+        const FileRecord &record = pRecords[i];
+        if (record.color > 1 || record.flag == EMPTY || record.flag > UPPER) continue;
+
+        Item &item = m_pTable[record.color][getHashIndex(record.hash)];
+        if (item.flag != EMPTY && item.depth >= record.depth) continue;
+        item.depth = record.depth;
+        item.hash = record.hash;
+        item.value = record.value;
+        item.flag = static_cast<Flag>(record.flag);
+    }
+
+    munmap(pData, st.st_size);
+    return cntRecords;
+}
+
+#define INSTANTIATE(N)                                                   \
+    template bool TT::save<N>(const char *path, int minDepth,           \
+                              const Signature &signature) const;        \
+    template int TT::load<N>(const char *path, const Signature &signature);
+GOMOKU_FOR_EACH_BOARD_SIZE(INSTANTIATE)
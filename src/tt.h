@@ -1,7 +1,10 @@
 #ifndef TT_H
 #define TT_H
 
+#include <cstdint>
+
 #include "board.h"
+#include "stats.h"
 
 /**
  * @class TT
@@ -27,13 +30,56 @@ class TT {
         int depth;               /**< Depth of the search when the entry was stored. */
         unsigned long long hash; /**< Hash value of the game position. */
         int value;               /**< Evaluation value of the game position. */
-        Flag flag = EMPTY;       /**< Flag indicating the type of the entry. */
+        Flag flag;               /**< Flag indicating the type of the entry. All-zero
+                                    bytes are an EMPTY entry. */
+    };
+
+    /**
+     * @struct Signature
+     * @brief The settings the saved values depend on besides the position. A file only
+     * loads into a search with the same signature.
+     */
+    struct Signature {
+        uint32_t rule;         /**< The Rule::TYPE of the search. */
+        int32_t blackWeight;   /**< The weight of black's score in the evaluation. */
+        uint64_t weightCheck;  /**< A checksum of the line type scores, the base weight
+                                  and the kill depth. */
+        uint64_t networkCheck; /**< Network::checksum() of the evaluating network, 0 for
+                                  the pattern scores. */
     };
 
     /**
-     * @brief Default constructor for the TT class.
+     * @struct FileHeader
+     * @brief The header of a saved table.
      */
-    TT();
+    struct FileHeader {
+        char magic[8];       /**< "GMKTT" padded with zero bytes. */
+        uint32_t version;    /**< The file format version. */
+        uint32_t boardSize;  /**< The board size the entries were searched on. */
+        uint64_t keyCheck;   /**< Zobrist::checksum() of the keys the entries were
+                                hashed with. */
+        Signature signature; /**< The settings the entries were searched with. */
+        uint64_t cntRecords; /**< The number of records. */
+    };
+
+    /**
+     * @struct FileRecord
+     * @brief A saved entry.
+     */
+    struct FileRecord {
+        uint64_t hash;  /**< Hash value of the game position. */
+        int32_t value;  /**< Evaluation value of the game position. */
+        int8_t depth;   /**< Depth of the search when the entry was stored. */
+        uint8_t flag;   /**< Flag indicating the type of the entry. */
+        uint8_t color;  /**< The color of the player to move. */
+        uint8_t padding; /**< Unused, zero. */
+    };
+
+    /**
+     * @brief Constructs an empty table.
+     * @param cntBits The log2 of the number of entries per color.
+     */
+    explicit TT(int cntBits = DEFAULT_BITS);
 
     /**
      * @brief Destructor for the TT class.
@@ -50,7 +96,7 @@ class TT {
      * @return The stored evaluation value if found, otherwise TT_NOT_HIT.
      */
     int find(unsigned long long hash, int depth, int alpha, int beta,
-             Board::PIECE_COLOR color) const;
+             BoardBase::PIECE_COLOR color) const;
 
     /**
      * @brief Inserts a game position into the transposition table.
@@ -61,7 +107,60 @@ class TT {
      * @param color The color of the current player.
      */
     void insert(unsigned long long hash, int depth, int value, Flag flag,
-                Board::PIECE_COLOR color);
+                BoardBase::PIECE_COLOR color);
+
+    /**
+     * @brief Saves the entries searched at least to a given depth.
+     * @note The file is written under a temporary name and renamed, so concurrent
+     * readers and writers never see a partial file.
+     * @tparam N The size of the board the entries were searched on.
+     * @param path The path of the file.
+     * @param minDepth The minimum depth of the saved entries.
+     * @param signature The settings the entries were searched with.
+     * @return True on success, false otherwise.
+     */
+    template <int N>
+    bool save(const char *path, int minDepth, const Signature &signature) const;
+
+    /**
+     * @brief Loads the entries of a saved table, keeping deeper entries already present.
+     * @tparam N The size of the board the entries are searched on.
+     * @param path The path of the file.
+     * @param signature The settings of the search the entries are loaded into.
+     * @return The number of records read, or -1 if the file is missing or was saved
+     * with another board size, other Zobrist keys or another signature.
+     */
+    template <int N>
+    int load(const char *path, const Signature &signature);
+
+    /**
+     * @brief The file format version.
+     */
+    const static uint32_t FILE_VERSION = 2;
+
+    /**
+     * @brief The default log2 of the number of entries per color, 48 MB in all.
+     */
+    const static int DEFAULT_BITS = 20;
+
+    /**
+     * @brief Gets the largest table that fits in a memory budget.
+     * @param megabytes The size of both colors' entries in megabytes.
+     * @return The log2 of the number of entries per color, at least 10.
+     */
+    static int bitsForSize(int megabytes);
+
+    /**
+     * @brief Gets the access counters.
+     * @note Only collected when compiled with GOMOKU_STATS.
+     * @return The access counters.
+     */
+    const TTStats &stats() const { return m_stats; }
+
+    /**
+     * @brief Resets the access counters.
+     */
+    void resetStats() { m_stats = TTStats(); }
 
     /**
      * @brief Value indicating that a transposition table entry was not found.
@@ -74,14 +173,11 @@ class TT {
      * @param hash The hash value of the game position.
      * @return The hash index.
      */
-    int getHashIndex(unsigned long long hash) const { return hash & 0xFFFFF; }
-
-    /**
-     * @brief Length of the transposition table.
-     */
-    const static int LENGTH = 1 << 20;
+    int getHashIndex(unsigned long long hash) const { return hash & (m_length - 1); }
 
+    int m_length;                           /**< The number of entries per color. */
     Item *m_pTable[2] = {nullptr, nullptr}; /**< Array of transposition table entries. */
+    mutable TTStats m_stats;                /**< Access counters. */
 };
 
 #endif
\ No newline at end of file
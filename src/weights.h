@@ -0,0 +1,24 @@
+#ifndef WEIGHTS_H
+#define WEIGHTS_H
+
+// The evaluation weights. gomoku_tune writes a file in this format; copy it over this one
+// to use tuned weights. FIVE, LIVE_FOUR, KILL_1 and DOUBLE_FOUR mark won lines for the
+// search and are never tuned.
+
+/**
+ * @brief The scores of the line types, see Scorer::TYPE_SCORES.
+ */
+#define GOMOKU_TYPE_SCORES \
+    {50000000, 5000000, 50000, 5000, 500, 500, 50, 50, 5, 0, 0, 5000000}
+
+/**
+ * @brief The weight of a move's distance to the edge, see Scorer::baseScore.
+ */
+#define GOMOKU_BASE_WEIGHT 1
+
+/**
+ * @brief The weight of black's scores, see EngineConfig::blackWeight.
+ */
+#define GOMOKU_BLACK_WEIGHT 5
+
+#endif
@@ -0,0 +1,136 @@
+// Builds an opening book from fixed-depth searches. Every position up to the given
+// number of plies reachable through the best move or one of the `width` best-scored
+// candidates is searched once; positions equal up to symmetry are searched only once.
+//
+// Usage: gomoku_book <output> [plies] [width] [depth] [zobrist seed]
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+#include "book.h"
+#include "core.h"
+#include "hash.h"
+
+namespace {
+
+/**
+ * @class Builder
+ * @brief Walks the opening tree and collects book entries.
+ */
+class Builder {
+   public:
+    Builder(int plies, int width, const EngineConfig &config)
+        : m_plies(plies),
+          m_width(width),
+          m_depth(config.minSearchDepth),
+          m_core(nullptr, Board::PIECE_COLOR::BLACK, config) {}
+
+    void build(Board::PIECE_COLOR color, int ply) {
+        if (ply >= m_plies) return;
+
+        int symmetry;
+        uint64_t key = m_board.getCanonicalHash(symmetry);
+        if (!m_visited.insert(key).second) return;
+
+        std::vector<MoveGenerator::Move> children;
+        if (ply == 0) {
+            // the search needs a piece on the board to generate moves around
+            children.push_back({Board::BOARD_SIZE / 2, Board::BOARD_SIZE / 2});
+        } else {
+            m_core.setBoard(&m_board, color);
+            m_core.initTimer();
+            m_core.run();
+            children.push_back(m_core.bestMove());
+            MoveGenerator generator = m_core.moveGenerator();
+            for (const MoveGenerator::Move &move : generator.generateMovesList(m_width)) {
+                if (!(move == children[0])) children.push_back(move);
+            }
+            children.resize(min(children.size(), (size_t)m_width));
+        }
+        if (children[0].x == -1) return;
+
+        Book::Entry entry = {};
+        MoveGenerator::Move image = children[0];
+        Zobrist::transform(image.x, image.y, symmetry);
+        entry.key = key;
+        entry.x = image.x;
+        entry.y = image.y;
+        entry.weight = ply == 0 ? UINT16_MAX : m_depth;
+        m_entries.push_back(entry);
+        if (m_entries.size() % 100 == 0) {
+            fprintf(stderr, "%zu positions\n", m_entries.size());
+        }
+
+        for (const MoveGenerator::Move &move : children) {
+            m_board.placeAt(move.x, move.y, color);
+            build(static_cast<Board::PIECE_COLOR>(color ^ 1), ply + 1);
+            m_board.unplaceAt(move.x, move.y);
+        }
+    }
+
+    bool write(const char *path) {
+        std::sort(m_entries.begin(), m_entries.end(),
+                  [](const Book::Entry &a, const Book::Entry &b) {
+                      return a.key != b.key ? a.key < b.key : a.weight > b.weight;
+                  });
+
+        Book::Header header = {};
+        std::memcpy(header.magic, Book::MAGIC, sizeof(header.magic));
+        header.version = Book::VERSION;
+        header.boardSize = Board::BOARD_SIZE;
+        header.keyCheck = Zobrist::checksum();
+        header.cntEntries = m_entries.size();
+
+        FILE *file = fopen(path, "wb");
+        if (!file) return false;
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                  fwrite(m_entries.data(), sizeof(Book::Entry), m_entries.size(), file) ==
+                      m_entries.size();
+        return fclose(file) == 0 && ok;
+    }
+
+    size_t size() const { return m_entries.size(); }
+
+   private:
+    static size_t min(size_t a, size_t b) { return a <= b ? a : b; }
+
+    int m_plies;
+    int m_width;
+    int m_depth;
+    Board m_board;
+    Core m_core;
+    std::unordered_set<uint64_t> m_visited;
+    std::vector<Book::Entry> m_entries;
+};
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <output> [plies] [width] [depth] [seed]\n", argv[0]);
+        return 1;
+    }
+    int plies = argc > 2 ? std::atoi(argv[2]) : 4;
+    int width = argc > 3 ? std::atoi(argv[3]) : 3;
+    int depth = argc > 4 ? std::atoi(argv[4]) : 8;
+    if (argc > 5) Zobrist::setSeed(std::strtoull(argv[5], nullptr, 0));
+
+    EngineConfig config;
+    config.iterativeDeepening = false;
+    config.minSearchDepth = depth;
+    config.timeLimit = INT_MAX;
+
+    Builder builder(plies, width, config);
+    builder.build(Board::PIECE_COLOR::BLACK, 0);
+    if (!builder.write(argv[1])) {
+        fprintf(stderr, "Cannot write %s\n", argv[1]);
+        return 1;
+    }
+    printf("%zu positions written to %s\n", builder.size(), argv[1]);
+    return 0;
+}
@@ -0,0 +1,254 @@
+// Plays engine-vs-engine games between two configurations and reports the result of
+// configuration A with its Elo difference and a sequential probability ratio test.
+//
+// Usage: gomoku_selfplay [--games n] [--jobs n] [--opening-plies n] [--seed n]
+//                        [--elo0 e] [--elo1 e] [--a key=value,...] [--b key=value,...]
+//                        [--record games.txt]
+// Keys: any EngineConfig setting, plus the short forms mindepth, maxdepth and weight
+// (black weight). time defaults to 100 ms per move. Both configurations must use the same
+// rule, which also adjudicates the games: a five wins as Rule::isWin decides, and a
+// forbidden move loses for black under renju.
+// --record writes every game as one line: the result for black (1, 0 or -1) followed by
+// the x and y of each move, the input of gomoku_tune.
+//
+// Every core carries its own settings, so the games run on worker threads of one
+// process. Every random opening is played twice with colors swapped.
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core.h"
+
+namespace {
+
+bool parseConfig(const char *str, EngineConfig &config) {
+    std::string s = str;
+    size_t pos = 0;
+    while (pos < s.size()) {
+        size_t end = s.find(',', pos);
+        if (end == std::string::npos) end = s.size();
+        std::string item = s.substr(pos, end - pos);
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) return false;
+        std::string key = item.substr(0, eq);
+        if (key == "mindepth") key = "min-depth";
+        if (key == "maxdepth") key = "max-depth";
+        if (key == "weight") key = "black-weight";
+        if (!config.set(key, item.substr(eq + 1))) return false;
+        pos = end + 1;
+    }
+    std::string error;
+    return config.validate(error);
+}
+
+/**
+ * @brief Checks if the piece at (x, y) completes a winning row, as Judger::checkFiveAt.
+ */
+bool isWin(const Board &board, int x, int y, Rule::TYPE rule) {
+    Board::BOARD_STATE state = board.getState(x, y);
+    Board::PIECE_COLOR color = static_cast<Board::PIECE_COLOR>(state);
+    for (int k = 0; k < 4; k++) {
+        // count the whole row, an overline does not win for every rule
+        int cnt = 1;
+        for (int sign = -1; sign <= 1; sign += 2) {
+            int tx = x + sign * Board::dr[k], ty = y + sign * Board::dc[k];
+            while (board.getState(tx, ty) == state) {
+                cnt++;
+                tx += sign * Board::dr[k];
+                ty += sign * Board::dc[k];
+            }
+        }
+        if (Rule::isWin(rule, color, cnt)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Plays one game.
+ * @param configs The configurations of A and B.
+ * @param blackIndex The index of the configuration playing black.
+ * @param opening The opening moves, black first.
+ * @param moves Receives the moves played, black first.
+ * @return 1 if black wins, -1 if white wins, 0 for a draw.
+ */
+int playGame(const EngineConfig configs[2], int blackIndex,
+             const std::vector<MoveGenerator::Move> &opening,
+             std::vector<MoveGenerator::Move> &moves) {
+    // each engine keeps its own board in sync through its core
+    Board boards[2];
+    int colors[2];
+    colors[blackIndex] = Board::PIECE_COLOR::BLACK;
+    colors[blackIndex ^ 1] = Board::PIECE_COLOR::WHITE;
+    Core *cores[2];
+    for (int i = 0; i < 2; i++) {
+        cores[i] =
+            new Core(&boards[i], static_cast<Board::PIECE_COLOR>(colors[i]), configs[i]);
+    }
+
+    int result = 0;
+    int color = Board::PIECE_COLOR::BLACK;
+    for (int ply = 0; ply < Board::BOARD_SIZE * Board::BOARD_SIZE; ply++, color ^= 1) {
+        int mover = colors[0] == color ? 0 : 1;
+        MoveGenerator::Move move;
+        if (ply < (int)opening.size()) {
+            move = opening[ply];
+        } else {
+            cores[mover]->initTimer();
+            cores[mover]->run();
+            move = cores[mover]->bestMove();
+        }
+
+        // an illegal move loses; only black has forbidden moves
+        if (boards[0].getState(move.x, move.y) != Board::BOARD_STATE::UNPLACE ||
+            (color == Board::PIECE_COLOR::BLACK &&
+             cores[0]->moveGenerator().isForbidden(move))) {
+            result = color == Board::PIECE_COLOR::BLACK ? -1 : 1;
+            break;
+        }
+        for (int i = 0; i < 2; i++) {
+            cores[i]->makeMove(move.x, move.y, static_cast<Board::PIECE_COLOR>(color));
+        }
+        moves.push_back(move);
+        if (isWin(boards[0], move.x, move.y, configs[0].rule)) {
+            result = color == Board::PIECE_COLOR::BLACK ? 1 : -1;
+            break;
+        }
+    }
+
+    for (int i = 0; i < 2; i++) delete cores[i];
+    return result;
+}
+
+std::vector<MoveGenerator::Move> randomOpening(std::mt19937 &rng, int cntPlies) {
+    std::vector<MoveGenerator::Move> opening;
+    Board board;
+    for (int ply = 0; ply < cntPlies; ply++) {
+        MoveGenerator::Move move;
+        do {
+            // stay near the center
+            move = {5 + (int)(rng() % 5), 5 + (int)(rng() % 5)};
+        } while (board.getState(move.x, move.y) != Board::BOARD_STATE::UNPLACE);
+        board.placeAt(move.x, move.y, static_cast<Board::PIECE_COLOR>((ply + 1) & 1));
+        opening.push_back(move);
+    }
+    return opening;
+}
+
+/**
+ * @brief Appends a game to the record file as one line.
+ */
+void recordGame(FILE *file, int result, const std::vector<MoveGenerator::Move> &moves) {
+    fprintf(file, "%d", result);
+    for (const MoveGenerator::Move &move : moves) fprintf(file, " %d %d", move.x, move.y);
+    fprintf(file, "\n");
+}
+
+double expectedScore(double elo) { return 1 / (1 + std::pow(10, -elo / 400)); }
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    int cntGames = 100, cntJobs = 1, cntOpeningPlies = 2, seed = 0;
+    double elo0 = 0, elo1 = 10;
+    const char *recordPath = nullptr;
+    EngineConfig configs[2];
+    configs[0].timeLimit = configs[1].timeLimit = 100;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--games")) {
+            cntGames = std::atoi(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--jobs")) {
+            cntJobs = std::atoi(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--opening-plies")) {
+            cntOpeningPlies = std::atoi(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--seed")) {
+            seed = std::atoi(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--elo0")) {
+            elo0 = std::atof(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--elo1")) {
+            elo1 = std::atof(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--record")) {
+            recordPath = argv[i + 1];
+        } else if (!std::strcmp(argv[i], "--a") && parseConfig(argv[i + 1], configs[0])) {
+        } else if (!std::strcmp(argv[i], "--b") && parseConfig(argv[i + 1], configs[1])) {
+        } else {
+            fprintf(stderr, "Invalid argument: %s %s\n", argv[i], argv[i + 1]);
+            return 1;
+        }
+    }
+    if (cntJobs < 1) cntJobs = 1;
+    if (configs[0].rule != configs[1].rule) {
+        fprintf(stderr, "Both configurations must play under the same rule\n");
+        return 1;
+    }
+
+    FILE *recordFile = nullptr;
+    if (recordPath) {
+        recordFile = fopen(recordPath, "w");
+        if (!recordFile) {
+            perror(recordPath);
+            return 1;
+        }
+    }
+
+    // the workers take the next game until all are played; results are from A's view
+    std::atomic<int> nextGame{0};
+    std::mutex mutex;
+    int wins = 0, losses = 0, draws = 0;
+    std::vector<std::thread> workers;
+    for (int job = 0; job < cntJobs; job++) {
+        workers.emplace_back([&]() {
+            for (int game = nextGame++; game < cntGames; game = nextGame++) {
+                std::mt19937 rng(seed * 1000003 + game / 2);
+                std::vector<MoveGenerator::Move> opening = randomOpening(rng, cntOpeningPlies);
+                int blackIndex = game & 1;
+                std::vector<MoveGenerator::Move> moves;
+                int result = playGame(configs, blackIndex, opening, moves);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (recordFile) recordGame(recordFile, result, moves);
+                if (result == 0) {
+                    draws++;
+                } else if ((result == 1) == (blackIndex == 0)) {
+                    wins++;
+                } else {
+                    losses++;
+                }
+            }
+        });
+    }
+    for (auto &worker : workers) worker.join();
+    if (recordFile) fclose(recordFile);
+
+    int n = wins + losses + draws;
+    printf("games: %d, A wins: %d, losses: %d, draws: %d\n", n, wins, losses, draws);
+    if (n == 0) return 0;
+
+    double score = (wins + draws / 2.0) / n;
+    double variance = (wins * std::pow(1 - score, 2) + losses * std::pow(score, 2) +
+                       draws * std::pow(0.5 - score, 2)) /
+                      n;
+    printf("score: %.4f\n", score);
+    if (score > 0 && score < 1) {
+        double elo = -400 * std::log10(1 / score - 1);
+        double margin = 1.96 * std::sqrt(variance / n);
+        double low = -400 * std::log10(1 / std::max(score - margin, 1e-6) - 1);
+        double high = -400 * std::log10(1 / std::min(score + margin, 1 - 1e-6) - 1);
+        printf("elo: %.1f (95%%: %.1f to %.1f)\n", elo, low, high);
+    }
+
+    // normal approximation of the log-likelihood ratio, alpha = beta = 0.05
+    double s0 = expectedScore(elo0), s1 = expectedScore(elo1);
+    double llr = variance > 0 ? n * (s1 - s0) * (2 * score - s0 - s1) / (2 * variance) : 0;
+    double lower = std::log(0.05 / 0.95), upper = std::log(0.95 / 0.05);
+    printf("sprt [%.1f, %.1f]: llr %.3f (%.3f, %.3f), %s\n", elo0, elo1, llr, lower, upper,
+           llr >= upper ? "H1 accepted" : llr <= lower ? "H0 accepted" : "inconclusive");
+    return 0;
+}
@@ -0,0 +1,375 @@
+// Tunes the evaluation weights with Texel's method: the static evaluation of positions
+// from recorded games, squashed by a logistic, is fitted to the game results by local
+// search, and the weights are written as a header in the format of src/weights.h.
+//
+// Usage: gomoku_tune games.txt [--out weights.h] [--threads n] [--skip-plies n]
+//                    [--passes n] [--rule freestyle|standard|renju]
+// games.txt holds one game per line as written by gomoku_selfplay --record.
+//
+// The evaluation is linear in the scores of the line types, so every position is reduced
+// once to counts of line types by the engine's own move generator and the search only
+// takes dot products. Positions where a player has a five, a four or a double four are
+// skipped: the fixed scores of those types stand for won lines, not for positional value.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core.h"
+
+namespace {
+
+/**
+ * @brief The line types whose scores are tuned.
+ */
+const Scorer::Type TUNED_TYPES[] = {Scorer::KILL_2,     Scorer::SLEEP_FOUR,
+                                    Scorer::LIVE_THREE, Scorer::SLEEP_THREE,
+                                    Scorer::LIVE_TWO,   Scorer::SLEEP_TWO};
+const int CNT_TUNED_TYPES = sizeof(TUNED_TYPES) / sizeof(TUNED_TYPES[0]);
+
+// the parameters are the tuned type scores, then the base and black weights
+const int BASE_PARAM = CNT_TUNED_TYPES;
+const int BLACK_PARAM = CNT_TUNED_TYPES + 1;
+const int CNT_PARAMS = CNT_TUNED_TYPES + 2;
+
+const char *PARAM_NAMES[CNT_PARAMS] = {"KILL_2",      "SLEEP_FOUR", "LIVE_THREE",
+                                       "SLEEP_THREE", "LIVE_TWO",   "SLEEP_TWO",
+                                       "BASE_WEIGHT", "BLACK_WEIGHT"};
+
+/**
+ * @brief The bounds of the parameters. Tuned type scores stay well below KILL_1, so that
+ * the search still tells a won move from any sum of positional scores.
+ */
+int paramBound(int param) {
+    if (param == BLACK_PARAM) return 20;
+    if (param == BASE_PARAM) return 1000;
+    return Scorer::TYPE_SCORES[Scorer::KILL_1] / 8;
+}
+
+int paramMin(int param) { return param == BLACK_PARAM ? 1 : 0; }
+
+/**
+ * @struct Sample
+ * @brief A position reduced to the features of both players and the game result.
+ */
+struct Sample {
+    int features[2][CNT_TUNED_TYPES + 1]; /**< The counts of the tuned types of every
+                                             move, then the sum of its edge distances. */
+    float result;                         /**< 1 if black won, 0.5 for a draw, else 0. */
+};
+
+/**
+ * @struct Game
+ * @brief A recorded game.
+ */
+struct Game {
+    int result;                             /**< 1, 0 or -1 for black. */
+    std::vector<MoveGenerator::Move> moves; /**< The moves, black first. */
+};
+
+bool readGames(const char *path, std::vector<Game> &games) {
+    std::ifstream fin(path);
+    if (!fin) return false;
+    std::string line;
+    while (getline(fin, line)) {
+        std::istringstream sin(line);
+        Game game;
+        if (!(sin >> game.result)) continue;
+        MoveGenerator::Move move;
+        while (sin >> move.x >> move.y) game.moves.push_back(move);
+        games.push_back(game);
+    }
+    return true;
+}
+
+/**
+ * @brief Reduces the position of a move generator to a sample.
+ * @return False if a player has a won line, whose score is not tuned.
+ */
+bool extract(const MoveGenerator &generator, Sample &sample) {
+    std::memset(sample.features, 0, sizeof(sample.features));
+    for (const MoveGenerator::Move &move : generator.m_moves) {
+        if (!generator.existsMove(move)) continue;
+        for (int c = 0; c < 2; c++) {
+            if (c == BoardBase::BLACK && generator.isForbidden(move)) continue;
+            int *features = sample.features[c];
+            for (int dir = 0; dir < 4; dir++) {
+                Scorer::Type type =
+                    generator.dirType(move, dir, static_cast<BoardBase::PIECE_COLOR>(c));
+                if (type <= Scorer::KILL_1 || type == Scorer::DOUBLE_FOUR) return false;
+                for (int i = 0; i < CNT_TUNED_TYPES; i++) {
+                    if (TUNED_TYPES[i] == type) features[i]++;
+                }
+            }
+
+            // the combination bonuses of MoveGenerator
+            int cntS4 = generator.cell(move).cntS4[c];
+            int cntL3 = generator.cell(move).cntL3[c];
+            if (cntS4 > 1) return false;
+            if (cntL3 > 1) features[0] += cntL3 - 1;
+            if (cntS4 && cntL3) features[0]++;
+            features[CNT_TUNED_TYPES] +=
+                Scorer::edgeDistance(move.x, move.y, Board::BOARD_SIZE);
+        }
+    }
+    return true;
+}
+
+double evaluate(const Sample &sample, const int params[CNT_PARAMS]) {
+    double sums[2];
+    for (int c = 0; c < 2; c++) {
+        sums[c] = 0;
+        for (int i = 0; i <= CNT_TUNED_TYPES; i++) {
+            sums[c] += (double)params[i] * sample.features[c][i];
+        }
+    }
+    return params[BLACK_PARAM] * sums[BoardBase::BLACK] - sums[BoardBase::WHITE];
+}
+
+/**
+ * @brief Replays games and collects the samples of their positions.
+ * @return The number of positions whose evaluation differs from Core::evaluate, which
+ * means the features do not describe the evaluation.
+ */
+int collectSamples(const std::vector<Game> &games, size_t begin, size_t end,
+                   int cntSkipPlies, const EngineConfig &config,
+                   const int params[CNT_PARAMS], std::vector<Sample> &samples) {
+    int cntMismatches = 0;
+    Core core(nullptr, BoardBase::BLACK, config);
+    for (size_t g = begin; g < end; g++) {
+        const Game &game = games[g];
+        Board board;
+        core.setBoard(&board, BoardBase::BLACK);
+        Sample sample;
+        sample.result = game.result > 0 ? 1 : game.result < 0 ? 0 : 0.5f;
+
+        int color = BoardBase::BLACK;
+        for (size_t ply = 0; ply < game.moves.size(); ply++, color ^= 1) {
+            const MoveGenerator::Move &move = game.moves[ply];
+            if (board.getState(move.x, move.y) != BoardBase::UNPLACE) break;
+            core.makeMove(move.x, move.y, static_cast<BoardBase::PIECE_COLOR>(color));
+            if ((int)ply + 1 < cntSkipPlies) continue;
+            if (!extract(core.moveGenerator(), sample)) continue;
+
+            if (evaluate(sample, params) != core.evaluate()) cntMismatches++;
+            samples.push_back(sample);
+        }
+    }
+    return cntMismatches;
+}
+
+/**
+ * @brief Computes the mean squared error of the predicted results in parallel.
+ */
+double meanError(const std::vector<Sample> &samples, const int params[CNT_PARAMS],
+                 double k, int cntThreads) {
+    std::vector<double> errors(cntThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < cntThreads; t++) {
+        threads.emplace_back([&, t]() {
+            double sum = 0;
+            for (size_t i = t; i < samples.size(); i += cntThreads) {
+                double predicted = 1 / (1 + std::exp(-k * evaluate(samples[i], params)));
+                double diff = samples[i].result - predicted;
+                sum += diff * diff;
+            }
+            errors[t] = sum;
+        });
+    }
+    double sum = 0;
+    for (int t = 0; t < cntThreads; t++) {
+        threads[t].join();
+        sum += errors[t];
+    }
+    return sum / samples.size();
+}
+
+/**
+ * @brief Finds the scale of the logistic that fits the current weights best, searching
+ * its exponent on a grid and then by ternary search.
+ */
+double fitScale(const std::vector<Sample> &samples, const int params[CNT_PARAMS],
+                int cntThreads) {
+    double bestExponent = -12, bestError = 1e9;
+    for (double exponent = -12; exponent <= 0; exponent += 0.25) {
+        double error = meanError(samples, params, std::pow(10, exponent), cntThreads);
+        if (error < bestError) {
+            bestError = error;
+            bestExponent = exponent;
+        }
+    }
+
+    double low = bestExponent - 0.25, high = bestExponent + 0.25;
+    for (int i = 0; i < 30; i++) {
+        double a = low + (high - low) / 3, b = high - (high - low) / 3;
+        if (meanError(samples, params, std::pow(10, a), cntThreads) <
+            meanError(samples, params, std::pow(10, b), cntThreads)) {
+            high = b;
+        } else {
+            low = a;
+        }
+    }
+    return std::pow(10, (low + high) / 2);
+}
+
+bool writeHeader(const char *path, const int params[CNT_PARAMS], size_t cntSamples,
+                 double error) {
+    int scores[Scorer::CNT_TYPES];
+    for (int i = 0; i < Scorer::CNT_TYPES; i++) scores[i] = Scorer::TYPE_SCORES[i];
+    for (int i = 0; i < CNT_TUNED_TYPES; i++) scores[TUNED_TYPES[i]] = params[i];
+
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file,
+            "#ifndef WEIGHTS_H\n"
+            "#define WEIGHTS_H\n\n"
+            "// The evaluation weights, tuned by gomoku_tune on %zu positions to a mean\n"
+            "// squared error of %.6f. FIVE, LIVE_FOUR, KILL_1 and DOUBLE_FOUR mark won\n"
+            "// lines for the search and are never tuned.\n\n"
+            "/**\n"
+            " * @brief The scores of the line types, see Scorer::TYPE_SCORES.\n"
+            " */\n"
+            "#define GOMOKU_TYPE_SCORES \\\n"
+            "    {",
+            cntSamples, error);
+    for (int i = 0; i < Scorer::CNT_TYPES; i++) {
+        fprintf(file, i ? ", %d" : "%d", scores[i]);
+    }
+    fprintf(file,
+            "}\n\n"
+            "/**\n"
+            " * @brief The weight of a move's distance to the edge, see "
+            "Scorer::baseScore.\n"
+            " */\n"
+            "#define GOMOKU_BASE_WEIGHT %d\n\n"
+            "/**\n"
+            " * @brief The weight of black's scores, see EngineConfig::blackWeight.\n"
+            " */\n"
+            "#define GOMOKU_BLACK_WEIGHT %d\n\n"
+            "#endif\n",
+            params[BASE_PARAM], params[BLACK_PARAM]);
+    fclose(file);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr,
+                "Usage: %s games.txt [--out weights.h] [--threads n] [--skip-plies n] "
+                "[--passes n] [--rule freestyle|standard|renju]\n",
+                argv[0]);
+        return 1;
+    }
+    const char *outPath = "weights.h";
+    EngineConfig config;
+    int cntThreads = std::thread::hardware_concurrency(), cntSkipPlies = 4,
+        cntPasses = 100;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--out")) {
+            outPath = argv[i + 1];
+        } else if (!std::strcmp(argv[i], "--threads")) {
+            cntThreads = std::atoi(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--skip-plies")) {
+            cntSkipPlies = std::atoi(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--passes")) {
+            cntPasses = std::atoi(argv[i + 1]);
+        } else if (!std::strcmp(argv[i], "--rule") && config.set("rule", argv[i + 1])) {
+        } else {
+            fprintf(stderr, "Invalid argument: %s %s\n", argv[i], argv[i + 1]);
+            return 1;
+        }
+    }
+    if (cntThreads < 1) cntThreads = 1;
+
+    std::vector<Game> games;
+    if (!readGames(argv[1], games)) {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    int params[CNT_PARAMS];
+    for (int i = 0; i < CNT_TUNED_TYPES; i++) {
+        params[i] = Scorer::TYPE_SCORES[TUNED_TYPES[i]];
+    }
+    params[BASE_PARAM] = GOMOKU_BASE_WEIGHT;
+    params[BLACK_PARAM] = config.blackWeight;
+
+    // every thread replays a contiguous range of games into its own samples
+    std::vector<std::vector<Sample>> parts(cntThreads);
+    std::vector<int> mismatches(cntThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < cntThreads; t++) {
+        threads.emplace_back([&, t]() {
+            mismatches[t] = collectSamples(games, games.size() * t / cntThreads,
+                                           games.size() * (t + 1) / cntThreads,
+                                           cntSkipPlies, config, params, parts[t]);
+        });
+    }
+    std::vector<Sample> samples;
+    int cntMismatches = 0;
+    for (int t = 0; t < cntThreads; t++) {
+        threads[t].join();
+        samples.insert(samples.end(), parts[t].begin(), parts[t].end());
+        cntMismatches += mismatches[t];
+    }
+    printf("games: %zu, positions: %zu\n", games.size(), samples.size());
+    if (cntMismatches) {
+        fprintf(stderr, "%d positions evaluate differently from Core::evaluate\n",
+                cntMismatches);
+        return 1;
+    }
+    if (samples.empty()) return 1;
+
+    double k = fitScale(samples, params, cntThreads);
+    double bestError = meanError(samples, params, k, cntThreads);
+    printf("scale: %g, error: %.6f\n", k, bestError);
+
+    // coordinate descent with relative steps, halved whenever a pass finds nothing
+    double ratio = 0.25;
+    for (int pass = 0; pass < cntPasses && ratio >= 1.0 / 64; pass++) {
+        bool improved = false;
+        for (int param = 0; param < CNT_PARAMS; param++) {
+            int value = params[param];
+            int step = (int)(value * ratio);
+            if (step < 1) step = 1;
+            for (int sign = -1; sign <= 1; sign += 2) {
+                int candidate = value + sign * step;
+                if (candidate < paramMin(param)) candidate = paramMin(param);
+                if (candidate > paramBound(param)) candidate = paramBound(param);
+                if (candidate == value) continue;
+
+                params[param] = candidate;
+                double error = meanError(samples, params, k, cntThreads);
+                if (error < bestError) {
+                    bestError = error;
+                    improved = true;
+                    break;
+                }
+                params[param] = value;
+            }
+        }
+        if (!improved) ratio /= 2;
+
+        printf("pass %d: error %.6f,", pass + 1, bestError);
+        for (int param = 0; param < CNT_PARAMS; param++) {
+            printf(" %s=%d", PARAM_NAMES[param], params[param]);
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+
+    if (!writeHeader(outPath, params, samples.size(), bestError)) {
+        fprintf(stderr, "Cannot write %s\n", outPath);
+        return 1;
+    }
+    printf("weights written to %s\n", outPath);
+    return 0;
+}